@@ -0,0 +1,52 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2025 Mark Wilson
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+//  https://www.boost.org/LICENSE_1_0.txt)
+//-----------------------------------------------------------------------------
+#include "AnyNMEAMessage.h"
+#include "ImmutableBuffer.h"
+#include "NMEADecodeStats.h"
+#include "NMEAExtractionStream.h"
+#include "NMEAInsertionStream.h"
+
+bool AnyNMEAMessage::readSentence(std::string_view sentence, void* value,
+                                  void (*extract)(void*, NMEAExtractionStream&))
+{
+    // Lazy, so the fields are only split as far as the payload type reads
+    NMEAExtractionStream stream(NMEAFieldScan::Lazy);
+    stream.rebind(ImmutableBuffer(sentence.data(), sentence.size()));
+    const NMEAMessageName name = stream.getHeader().name();
+
+    // NMEAMessageRegistry::decodeDeferred leaves the count to this first extraction
+    NMEA_TRY
+    {
+        extract(value, stream);
+    }
+    NMEA_CATCH_ALL
+    {
+        recordNMEADecode(NMEADecodeStatus::DecodeFailed, name);
+        NMEA_RETHROW;
+    }
+
+    // A stray '*' the scan only found now: the stream has counted it as BadFraming
+    if ( !stream.isFramed() )
+        return false;
+
+    const bool parsed = stream.good();
+    recordNMEADecode(parsed ? NMEADecodeStatus::Ok : NMEADecodeStatus::DecodeFailed, name);
+    return parsed;
+}
+
+void AnyNMEAMessage::writeFields(std::string_view sentence, NMEAInsertionStream& ns)
+{
+    // Everything from the first field up to the '*' in one go: with the ','s between the
+    // fields, it is what inserting them one by one would have written. The sentence came
+    // in whole, so it goes out whole, trailer and all.
+    const std::size_t begin = sentence.find(',');
+    const std::size_t end = sentence.rfind('*');
+    if ( begin != std::string_view::npos && end != std::string_view::npos && begin < end )
+        ns << sentence.substr(begin + 1, end - begin - 1);
+    ns << NMEAInsertionStream::EndMsg();
+}
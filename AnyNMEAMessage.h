@@ -9,117 +9,376 @@
 
 // AnyNMEAMessage.hpp
 #pragma once
+#include <atomic>
 #include <cstdint>
 #include <cstddef>
 #include <memory>
+#include <memory_resource>
+#include <new>
 #include <stdexcept>
 #include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
 #include <typeinfo>
 #include <utility>
 
+#include "NMEAExceptions.h"
+#include "NMEAHeader.h"
+
 using namespace std;
 
 // Your stream types (use your real headers)
 class NMEAInsertionStream;
 class NMEAExtractionStream;
 
-// ADL hooks you define beside each message type
+// ADL hooks you define beside each message type (NMEASchema.h defines them for types
+// described by an NMEASchema)
 template <class T> NMEAInsertionStream& operator<<(NMEAInsertionStream&, const T&);
 template <class T> NMEAExtractionStream& operator>>(NMEAExtractionStream&, T&);
 
-// Optional trait: specialize per message type to supply its 3-letter code
+// Compile-time field list of a message type; see NMEASchema.h
+template <class T> struct NMEASchema;
+
+// Optional trait: specialize per message type to supply its 3-letter code.
+// Prefer a constexpr NMEAMessageName; a std::string returning specialization still works.
+// Types with an NMEASchema get the schema's name without specializing this.
 template <class T>
 struct NMEATraits
 {
-    static std::string messageName(); // e.g. return "GGA"
+    static constexpr NMEAMessageName messageName() { return NMEASchema<T>::messageName(); }
 };
 
 class AnyNMEAMessage
 {
+    struct Operations;
+    template <class T> struct Model;
+
 public:
+    /**
+     * @brief Size and alignment of the buffer every AnyNMEAMessage reserves for its payload.
+     * Payloads that fit (and can be moved without throwing) never touch the heap.
+     */
+    static constexpr std::size_t InlineCapacity  = 64;
+    static constexpr std::size_t InlineAlignment = alignof(std::max_align_t);
+
+    /**
+     * @brief storesInline tells, at compile time, whether a T payload lives in the
+     * inline buffer (true) or falls back to an allocation from the message's
+     * std::pmr::memory_resource (false).
+     */
+    template <class T>
+    static constexpr bool storesInline() noexcept
+    {
+        return sizeof(T) <= InlineCapacity
+            && alignof(T) <= InlineAlignment
+            && std::is_nothrow_move_constructible<T>::value;
+    }
+
+    /**
+     * @brief TypeId identifies a payload type. It is the address of a per-type tag, so
+     * comparing two ids is a single pointer compare (no std::type_info involved).
+     */
+    using TypeId = const void*;
+
+    template <class T>
+    static constexpr TypeId typeId() noexcept { return &TypeTag<std::decay_t<T>>::tag; }
+
+    /**
+     * @brief TypeIndex is a small dense number per payload type, for indexing tables by type
+     * (see NMEADispatcher). Types are numbered from 1 in the order they are first asked for,
+     * so the numbers differ between runs; 0 stands for an empty message.
+     */
+    using TypeIndex = std::uint32_t;
+
+    template <class T>
+    static TypeIndex typeIndex() noexcept { return indexOf(typeId<T>()); }
+
+    //
+    // Memory resources follow the std::pmr container rules. Payloads that do not fit inline
+    // are allocated from the resource a message was constructed with (the default resource
+    // if none is given), and that resource never changes for the life of the message:
+    // - a move constructed message takes the source's resource along with its payload;
+    // - a copy constructed message uses the default resource, unless one is passed to the
+    //   allocator-extended copy constructor, so a copy can outlive the source's arena;
+    // - assignment keeps the target's resource; payloads are only handed over between
+    //   equal resources, otherwise they are moved or copied into the target's.
+    //
+
     AnyNMEAMessage() = default;
 
+    explicit AnyNMEAMessage(std::pmr::memory_resource* resource) noexcept
+        : resource_(resource)
+    {
+    }
+
     // talker + explicit messageName + value
     template <class T>
-    AnyNMEAMessage(std::string talker, std::string messageName, T value)
-        : self_(std::make_unique<Model<T>>(std::move(value)))
-        , talker_(std::move(talker))
-        , messageName_(std::move(messageName))
+    AnyNMEAMessage(std::string_view talker, std::string_view messageName, T value,
+                   std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+        : header_(talker, NMEAMessageName(messageName))
+        , resource_(resource)
     {
-        validateTalkerHeader();
+        validateTalkerHeader(talker, messageName);
+        emplace<T>(std::move(value));
     }
 
     // talker + value, messageName deduced via NMEATraits<T>
     template <class T>
-    AnyNMEAMessage(std::string talker, T value)
-        : self_(std::make_unique<Model<T>>(std::move(value)))
-        , talker_(std::move(talker))
-        , messageName_(NMEATraits<T>::messageName())
+    AnyNMEAMessage(std::string_view talker, T value,
+                   std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+        : header_(talker, NMEAMessageName(NMEATraits<T>::messageName()))
+        , resource_(resource)
+    {
+        validateTalkerHeader(talker, header_.messageName());
+        emplace<T>(std::move(value));
+    }
+
+    // already validated header + value
+    template <class T>
+    AnyNMEAMessage(const NMEAHeader& header, T value,
+                   std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+        : header_(header)
+        , resource_(resource)
     {
-        validateTalkerHeader();
+        validateTalkerHeader(header_.talker(), header_.messageName());
+        emplace<T>(std::move(value));
     }
 
     // Copy / move
     AnyNMEAMessage(const AnyNMEAMessage& o)
-        : self_(o.self_ ? o.self_->clone() : nullptr)
-        , talker_(o.talker_)
-        , messageName_(o.messageName_)
+        : AnyNMEAMessage(o, std::pmr::get_default_resource())
+    {
+    }
+
+    AnyNMEAMessage(const AnyNMEAMessage& o, std::pmr::memory_resource* resource)
+        : header_(o.header_)
+        , resource_(resource)
         , checksum_(o.checksum_)
         , size_(o.size_)
-    {}
+    {
+        copyPayload(o);
+    }
 
     AnyNMEAMessage& operator=(const AnyNMEAMessage& o)
     {
         if (this != &o)
         {
-            self_         = o.self_ ? o.self_->clone() : nullptr;
-            talker_       = o.talker_;
-            messageName_  = o.messageName_;
+            AnyNMEAMessage copy(o, resource_);
+            *this = std::move(copy);
+        }
+        return *this;
+    }
+
+    AnyNMEAMessage(AnyNMEAMessage&& o) noexcept
+        : header_(o.header_)
+        , resource_(o.resource_)
+        , checksum_(o.checksum_)
+        , size_(o.size_)
+    {
+        takePayload(o);
+    }
+
+    AnyNMEAMessage(AnyNMEAMessage&& o, std::pmr::memory_resource* resource)
+        : header_(o.header_)
+        , resource_(resource)
+        , checksum_(o.checksum_)
+        , size_(o.size_)
+    {
+        movePayload(o);
+    }
+
+    /// Only throws if the resources differ and allocating from this one throws, which
+    /// leaves this message unchanged.
+    AnyNMEAMessage& operator=(AnyNMEAMessage&& o)
+    {
+        if (this != &o)
+        {
+            // Moving into an allocation from our resource may throw: do it before giving up
+            // the old payload, as copy assignment does
+            if (!hasEqualResource(o))
+            {
+                AnyNMEAMessage moved(std::move(o), resource_);
+                return *this = std::move(moved);
+            }
+
+            reset();
+            takePayload(o);
+            header_       = o.header_;
             checksum_     = o.checksum_;
             size_         = o.size_;
         }
         return *this;
     }
 
-    AnyNMEAMessage(AnyNMEAMessage&&) noexcept = default;
-    AnyNMEAMessage& operator=(AnyNMEAMessage&&) noexcept = default;
+    ~AnyNMEAMessage() { reset(); }
 
-    bool isEmpty() const { return self_ == nullptr; }
+    bool isEmpty() const { return ops_ == nullptr; }
+
+    /// @return The resource payloads too large for the inline buffer are allocated from.
+    std::pmr::memory_resource* getMemoryResource() const noexcept { return resource_; }
 
     explicit operator bool() const noexcept { return isEmpty(); }
 
     // Type queries / access
+
+    /**
+     * @brief type is kept for compatibility; prefer isType<T>() or getTypeId(), which
+     * avoid std::type_info comparisons.
+     */
     const std::type_info& type() const noexcept
     {
-        return self_ ? self_->type() : typeid(void);
+        return ops_ ? ops_->type() : typeid(void);
     }
 
+    /// @return The TypeId of the payload, or nullptr when empty.
+    TypeId getTypeId() const noexcept { return ops_ ? ops_->typeId : nullptr; }
+
+    /// @return The TypeIndex of the payload, or 0 when empty.
+    TypeIndex getTypeIndex() const noexcept { return ops_ ? indexOf(ops_->typeId) : 0; }
+
     template <class T>
-    bool isType() const
+    bool isType() const noexcept
     {
-        return self_ && (self_->type() == typeid(T));
+        return ops_ && ops_->typeId == typeId<T>();
     }
 
+    /// Detaches a shared payload first (see makeShared()), copying it if others hold it,
+    /// and extracts a deferred one into a payload of this message's own (see deferred()).
+    /// Throws if a deferred payload's fields do not parse.
     template <class T>
     T& get()
     {
         checkType<T>();
-        return static_cast<Model<T>*>(self_.get())->value_;
+        checkDecoded();
+        detach();
+        return *payload<T>();
     }
 
     template <class T>
     const T& get() const
     {
         checkType<T>();
-        return static_cast<const Model<T>*>(self_.get())->value_;
+        checkDecoded();
+        return *payload<T>();
+    }
+
+    /// @return The payload if it is a T, otherwise nullptr. Also nullptr if the payload is
+    /// deferred and its fields do not parse. Never throws, except that detaching a shared
+    /// payload may fail to allocate.
+    template <class T>
+    T* tryGet()
+    {
+        if (!isType<T>() || !isDecoded())
+            return nullptr;
+        detach();
+        return payload<T>();
+    }
+
+    /// @return The payload if it is a T, otherwise nullptr. Also nullptr if the payload is
+    /// deferred (see deferred()) and its fields do not parse or extracting it throws.
+    template <class T>
+    const T* tryGet() const noexcept
+    {
+        if (!isType<T>())
+            return nullptr;
+        NMEA_TRY
+        {
+            return payload<T>();
+        }
+        NMEA_CATCH_ALL
+        {
+            return nullptr;
+        }
+    }
+
+    //
+    // Shared mode, for fanning one message out to many holders. After makeShared() the
+    // payload lives in one heap block with an atomic reference count, and copying the
+    // message (or copies of it) only bumps the count instead of cloning the payload.
+    // Thread safety is that of std::shared_ptr<const T>: different AnyNMEAMessage objects
+    // sharing a payload may be read, copied and destroyed concurrently; one object used by
+    // several threads needs external synchronization. The non-const get<T>(), tryGet<T>()
+    // and deserialize() copy the payload into a block of this holder's own first (copy on
+    // write), unless it is the only holder.
+    //
+    // A copy only shares when its memory resource is equal to the source's; otherwise it
+    // gets its own shared block from its resource.
+    //
+
+    /**
+     * @brief makeShared moves the payload into a reference counted block, so later copies
+     * share it. Does nothing if empty or already shared.
+     */
+    void makeShared()
+    {
+        if (ops_ && !ops_->shared)
+            ops_ = ops_->share(storage_, resource_);
+    }
+
+    bool isShared() const noexcept { return ops_ && ops_->shared; }
+
+    /// @return How many messages hold this payload: 0 if empty, 1 if not shared.
+    std::size_t useCount() const noexcept
+    {
+        if (!ops_)
+            return 0;
+        return ops_->shared ? static_cast<const SharedCount*>(storage_.heap)->refs.load(std::memory_order_acquire) : 1;
+    }
+
+    //
+    // Deferred mode, for traffic that is mostly filtered by type or header, or forwarded,
+    // and seldom looked into. A deferred message holds a copy of the raw sentence and knows
+    // its header and payload type, but extracts the payload only on the first get<T>() or
+    // tryGet<T>(). serialize() writes the sentence's original fields back out, decoded or
+    // not, and ends it with the "*hh\r\n" trailer. The sentence lives in a reference
+    // counted block like a shared payload (copies share it, isShared() is true), so the
+    // payload is extracted at most once for all the copies, and threads may make that first
+    // access concurrently, on one message or on several. The non-const get<T>(), tryGet<T>()
+    // and deserialize() turn the message into an ordinary one holding its own decoded
+    // payload, as the sentence would go stale.
+    //
+
+    /**
+     * @brief deferred makes a message of type T from a sentence without extracting it.
+     * NMEAMessageRegistry::decodeDeferred() is the usual way to get one.
+     *
+     * Field errors show up on first access, not here: if a field is Invalid, OutOfRange or
+     * Missing when the payload is extracted, or the lazy scan only then finds the sentence
+     * unframed, there is no payload. get<T>() throws and tryGet<T>() returns nullptr from
+     * then on, and the sentence is counted in the decode statistics at that point (see
+     * NMEAMessageRegistry::decodeDeferred()).
+     * @param header Talker and message name of sentence.
+     * @param sentence The whole "$...*hh" sentence; copied into the message.
+     * @param resource Where the copy of sentence is allocated.
+     */
+    template <class T>
+    static AnyNMEAMessage deferred(const NMEAHeader& header, std::string_view sentence,
+                                   std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+    {
+        using U = std::decay_t<T>;
+        AnyNMEAMessage message(resource);
+        message.header_ = header;
+        message.validateTalkerHeader(header.talker(), header.messageName());
+        DeferredModel<U>::create(message.storage_, sentence, resource);
+        message.ops_ = &DeferredModel<U>::operations;
+        return message;
+    }
+
+    /// @return true if the message holds a raw sentence, whether or not it has been decoded.
+    bool isDeferred() const noexcept { return ops_ && ops_->decoded; }
+
+    /// @return The raw sentence of a deferred message, otherwise empty.
+    std::string_view getSentence() const noexcept
+    {
+        return isDeferred() ? static_cast<const DeferredSentence*>(storage_.heap)->sentence : std::string_view();
     }
 
     // Serialization / deserialization — payload only; your ADL frames/deframes
     void serialize(NMEAInsertionStream& ns) const
     {
-        if (!self_) throw std::runtime_error("Empty AnyNMEAMessage");
-        using ::operator<<;      // ADL
-        self_->write(ns);        // ns << value_;
+        if (!ops_) NMEA_THROW(std::runtime_error("Empty AnyNMEAMessage"));
+        ops_->write(storage_, ns);    // ns << value;
         // If your inserter exposes these, feel free to uncomment:
         // checksum_ = ns.checksum();
         // size_     = ns.size();
@@ -127,9 +386,9 @@ public:
 
     void deserialize(NMEAExtractionStream& ex)
     {
-        if (!self_) throw std::runtime_error("Empty AnyNMEAMessage");
-        using ::operator>>;      // ADL
-        self_->read(ex);         // ex >> value_;
+        if (!ops_) NMEA_THROW(std::runtime_error("Empty AnyNMEAMessage"));
+        detach();
+        ops_->read(storage_, ex);     // ex >> value;
         // If your extractor exposes these, you can cache them:
         // talker_   = ex.talker();
         // header_   = ex.header();
@@ -137,69 +396,562 @@ public:
         // size_     = ex.size();
     }
 
+    /// @return false, writing nothing, if the message is empty.
+    bool trySerialize(NMEAInsertionStream& ns) const
+    {
+        if (!ops_)
+            return false;
+        ops_->write(storage_, ns);
+        return true;
+    }
+
+    /// @return false, reading nothing, if the message is empty.
+    bool tryDeserialize(NMEAExtractionStream& ex)
+    {
+        if (!ops_)
+            return false;
+        detach();
+        ops_->read(storage_, ex);
+        return true;
+    }
+
     // Read-only metadata (set at construction; optionally refresh internally after (de)serialize)
-    const std::string& getTalker()      const noexcept { return talker_; }
-    const std::string& getMessageName() const noexcept { return messageName_; }
+    std::string_view   getTalker()      const noexcept { return header_.talker(); }
+    std::string_view   getMessageName() const noexcept { return header_.messageName(); }
+    const NMEAHeader&  getHeader()      const noexcept { return header_; }
     std::uint8_t       getChecksum()    const noexcept { return checksum_; }
     std::size_t        getSize()        const noexcept { return size_; }
 
 private:
-    // Type-erasure core
-    struct Concept
-    {
-        virtual ~Concept() = default;
-        virtual std::unique_ptr<Concept> clone() const = 0;
-        virtual const std::type_info& type() const noexcept = 0;
-        virtual void write(NMEAInsertionStream&) const = 0; // ADL payload write
-        virtual void read (NMEAExtractionStream&)      = 0; // ADL payload read
+    friend class NMEADispatcher;
+
+    // One per payload type: its address is the TypeId, and it remembers the TypeIndex once
+    // one has been handed out. Constant initialized, so usable before main().
+    struct TypeSlot
+    {
+        mutable std::atomic<TypeIndex> index {0};
+    };
+
+    template <class T>
+    struct TypeTag
+    {
+        static inline TypeSlot tag {};
+    };
+
+    static TypeIndex indexOf(TypeId id) noexcept
+    {
+        auto& index = static_cast<const TypeSlot*>(id)->index;
+        if (const TypeIndex known = index.load(std::memory_order_relaxed))
+            return known;
+
+        // First use of this type: number it. A thread losing the race takes the winner's
+        // number, which leaves a gap in the numbering but no duplicates.
+        static std::atomic<TypeIndex> next {0};
+        TypeIndex expected = 0;
+        const TypeIndex fresh = next.fetch_add(1, std::memory_order_relaxed) + 1;
+        return index.compare_exchange_strong(expected, fresh, std::memory_order_relaxed) ? fresh : expected;
+    }
+
+    // Payload bytes: the value itself when storesInline<T>(), otherwise a pointer to memory
+    // from the message's resource.
+    union Storage
+    {
+        void* heap;
+        alignas(InlineAlignment) unsigned char buffer[InlineCapacity];
+    };
+
+    // Type-erasure core: one constexpr table of plain function pointers per payload type,
+    // shared by every AnyNMEAMessage holding that type. Replaces a virtual Concept.
+    struct Operations
+    {
+        TypeId typeId;
+        const std::type_info& (*type)() noexcept;
+        void (*clone)(const Storage& src, Storage& dst, std::pmr::memory_resource*);
+        void (*move)(Storage& src, Storage& dst) noexcept;  // leaves src destroyed; same resource only
+        void (*moveTo)(Storage& src, Storage& dst, std::pmr::memory_resource*); // src left moved-from
+        void (*destroy)(Storage&, std::pmr::memory_resource*) noexcept;
+        void (*write)(const Storage&, NMEAInsertionStream&); // ADL payload write
+        void (*read)(Storage&, NMEAExtractionStream&);       // ADL payload read
+
+        bool shared;                                          // storage points at a block starting with a SharedCount
+        const Operations* (*share)(Storage&, std::pmr::memory_resource*); // Model<T> only: to shared mode
+        const Operations* (*detach)(Storage&, std::pmr::memory_resource*); // shared modes: make the payload ours alone
+        const void* (*decoded)(const Storage&);               // DeferredModel<T> only: the payload, extracted on first call; nullptr if unparsable
+    };
+
+    // Reference count at the start of every shared payload block, whatever its type
+    struct SharedCount
+    {
+        std::atomic<std::size_t> refs {1};
+    };
+
+    template <class T>
+    struct SharedBlock : SharedCount
+    {
+        template <class U>
+        explicit SharedBlock(U&& v) : value(std::forward<U>(v)) {}
+
+        T value;
+    };
+
+    template <class T>
+    struct Model
+    {
+        static constexpr bool Inline = storesInline<T>();
+
+        static T* ptr(Storage& s) noexcept
+        {
+            if constexpr (Inline)
+                return std::launder(reinterpret_cast<T*>(s.buffer));
+            else
+                return static_cast<T*>(s.heap);
+        }
+
+        static const T* ptr(const Storage& s) noexcept
+        {
+            if constexpr (Inline)
+                return std::launder(reinterpret_cast<const T*>(s.buffer));
+            else
+                return static_cast<const T*>(s.heap);
+        }
+
+        template <class U>
+        static void create(Storage& s, U&& value, std::pmr::memory_resource* resource)
+        {
+            if constexpr (Inline)
+                ::new (static_cast<void*>(s.buffer)) T(std::forward<U>(value));
+            else
+            {
+                void* p = resource->allocate(sizeof(T), alignof(T));
+                NMEA_TRY
+                {
+                    s.heap = ::new (p) T(std::forward<U>(value));
+                }
+                NMEA_CATCH_ALL
+                {
+                    resource->deallocate(p, sizeof(T), alignof(T));
+                    NMEA_RETHROW;
+                }
+            }
+        }
+
+        static const std::type_info& type() noexcept { return typeid(T); }
+
+        static void clone(const Storage& src, Storage& dst, std::pmr::memory_resource* resource)
+        {
+            create(dst, *ptr(src), resource);
+        }
+
+        static void moveTo(Storage& src, Storage& dst, std::pmr::memory_resource* resource)
+        {
+            create(dst, std::move(*ptr(src)), resource);
+        }
+
+        static void move(Storage& src, Storage& dst) noexcept
+        {
+            if constexpr (Inline)
+            {
+                ::new (static_cast<void*>(dst.buffer)) T(std::move(*ptr(src)));
+                ptr(src)->~T();
+            }
+            else
+            {
+                dst.heap = src.heap;
+                src.heap = nullptr;
+            }
+        }
+
+        static void destroy(Storage& s, std::pmr::memory_resource* resource) noexcept
+        {
+            ptr(s)->~T();
+            if constexpr (!Inline)
+                resource->deallocate(s.heap, sizeof(T), alignof(T));
+        }
+
+        static void write(const Storage& s, NMEAInsertionStream& ns)
+        {
+            using ::operator<<; ns << *ptr(s);
+        }
+
+        static void read(Storage& s, NMEAExtractionStream& ex)
+        {
+            using ::operator>>; ex >> *ptr(s);
+        }
+
+        static const Operations* share(Storage& s, std::pmr::memory_resource* resource)
+        {
+            Storage shared;
+            SharedModel<T>::create(shared, std::move(*ptr(s)), resource);
+            destroy(s, resource);
+            s.heap = shared.heap;
+            return &SharedModel<T>::operations;
+        }
+
+        static constexpr Operations operations {
+            typeId<T>(), &type, &clone, &move, &moveTo, &destroy, &write, &read,
+            false, &share, nullptr, nullptr
+        };
     };
 
+    // The shared mode of a T payload: Storage::heap points at a SharedBlock<T> allocated
+    // from the holders' (equal) memory resource.
     template <class T>
-    struct Model final : Concept
+    struct SharedModel
     {
-        T value_;
+        using Block = SharedBlock<T>;
+
+        static Block* block(const Storage& s) noexcept { return static_cast<Block*>(s.heap); }
 
-        explicit Model(T v)
-            : value_(std::move(v))
-        {}
+        static T* ptr(Storage& s) noexcept { return &block(s)->value; }
 
-        std::unique_ptr<Concept> clone() const override
+        static const T* ptr(const Storage& s) noexcept { return &block(s)->value; }
+
+        template <class U>
+        static void create(Storage& s, U&& value, std::pmr::memory_resource* resource)
+        {
+            void* p = resource->allocate(sizeof(Block), alignof(Block));
+            NMEA_TRY
+            {
+                s.heap = ::new (p) Block(std::forward<U>(value));
+            }
+            NMEA_CATCH_ALL
+            {
+                resource->deallocate(p, sizeof(Block), alignof(Block));
+                NMEA_RETHROW;
+            }
+        }
+
+        // A block of dst's own; copyPayload() shares instead when the resources are equal
+        static void clone(const Storage& src, Storage& dst, std::pmr::memory_resource* resource)
+        {
+            create(dst, *ptr(src), resource);
+        }
+
+        static void move(Storage& src, Storage& dst) noexcept
+        {
+            dst.heap = src.heap;
+            src.heap = nullptr;
+        }
+
+        static void moveTo(Storage& src, Storage& dst, std::pmr::memory_resource* resource)
+        {
+            if (block(src)->refs.load(std::memory_order_acquire) == 1)
+                create(dst, std::move(*ptr(src)), resource);
+            else
+                create(dst, *ptr(src), resource);
+        }
+
+        static void destroy(Storage& s, std::pmr::memory_resource* resource) noexcept
         {
-            return std::make_unique<Model<T>>(value_);
+            Block* b = block(s);
+            if (b && b->refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            {
+                b->~Block();
+                resource->deallocate(b, sizeof(Block), alignof(Block));
+            }
         }
 
-        const std::type_info& type() const noexcept override
+        static void write(const Storage& s, NMEAInsertionStream& ns)
         {
-            return typeid(T);
+            using ::operator<<; ns << *ptr(s);
         }
 
-        void write(NMEAInsertionStream& ns) const override
+        static void read(Storage& s, NMEAExtractionStream& ex)
         {
-            using ::operator<<; ns << value_;
+            using ::operator>>; ex >> *ptr(s);
         }
 
-        void read(NMEAExtractionStream& ex) override
+        static const Operations* detach(Storage& s, std::pmr::memory_resource* resource)
         {
-            using ::operator>>; ex >> value_;
+            if (block(s)->refs.load(std::memory_order_acquire) == 1)
+                return &operations;
+
+            Storage own;
+            create(own, *ptr(s), resource);
+            destroy(s, resource);
+            s.heap = own.heap;
+            return &operations;
         }
+
+        static constexpr Operations operations {
+            typeId<T>(), &Model<T>::type, &clone, &move, &moveTo, &destroy, &write, &read,
+            true, nullptr, &detach, nullptr
+        };
     };
 
+    // Start of every deferred block, whatever its payload type. The sentence is copied right
+    // after the block.
+    struct DeferredSentence : SharedCount
+    {
+        enum State : std::uint8_t { Pending, Extracting, Ready, Failed };
+
+        explicit DeferredSentence(std::string_view s) noexcept : sentence(s) {}
+
+        std::string_view sentence;
+        std::atomic<std::uint8_t> state {Pending};
+    };
+
+    template <class T>
+    struct DeferredBlock : DeferredSentence
+    {
+        using DeferredSentence::DeferredSentence;
+
+        ~DeferredBlock()
+        {
+            if (state.load(std::memory_order_acquire) == Ready)
+                std::launder(reinterpret_cast<T*>(value))->~T();
+        }
+
+        alignas(T) unsigned char value[sizeof(T)];
+    };
+
+    // The deferred mode of a T payload: Storage::heap points at a DeferredBlock<T> followed by
+    // the sentence, allocated from the holders' (equal) memory resource.
+    template <class T>
+    struct DeferredModel
+    {
+        using Block = DeferredBlock<T>;
+
+        static Block* block(const Storage& s) noexcept { return static_cast<Block*>(s.heap); }
+
+        static void create(Storage& s, std::string_view sentence, std::pmr::memory_resource* resource)
+        {
+            char* p = static_cast<char*>(resource->allocate(sizeof(Block) + sentence.size(), alignof(Block)));
+            char* copy = p + sizeof(Block);
+            sentence.copy(copy, sentence.size());
+            s.heap = ::new (static_cast<void*>(p)) Block(std::string_view(copy, sentence.size()));
+        }
+
+        // Thread safe: the first caller extracts, concurrent ones yield until it is done. If
+        // the extraction throws, the next call tries again. (Not std::call_once, which
+        // libstdc++ leaves locked when the callable throws.) @return nullptr if the fields
+        // do not parse.
+        static T* ptr(const Storage& s)
+        {
+            Block* b = block(s);
+            std::uint8_t state = b->state.load(std::memory_order_acquire);
+            while (state == Block::Pending || state == Block::Extracting)
+            {
+                if (state == Block::Pending
+                    && b->state.compare_exchange_strong(state, Block::Extracting, std::memory_order_acquire))
+                {
+                    state = extractOnce(*b);
+                    break;
+                }
+                std::this_thread::yield();
+                state = b->state.load(std::memory_order_acquire);
+            }
+            return state == Block::Ready ? std::launder(reinterpret_cast<T*>(b->value)) : nullptr;
+        }
+
+        static std::uint8_t extractOnce(Block& b)
+        {
+            T* value = nullptr;
+            bool parsed = false;
+            NMEA_TRY
+            {
+                value = ::new (static_cast<void*>(b.value)) T {};
+                parsed = readSentence(b.sentence, value, &extract);
+            }
+            NMEA_CATCH_ALL
+            {
+                if (value)
+                    value->~T();
+                b.state.store(Block::Pending, std::memory_order_release);
+                NMEA_RETHROW;
+            }
+
+            // No partial payloads, as with an eager decode; the failure is final
+            if (!parsed)
+                value->~T();
+            const std::uint8_t state = parsed ? Block::Ready : Block::Failed;
+            b.state.store(state, std::memory_order_release);
+            return state;
+        }
+
+        static const void* decoded(const Storage& s) { return ptr(s); }
+
+        static void extract(void* value, NMEAExtractionStream& ex)
+        {
+            using ::operator>>; ex >> *static_cast<T*>(value);
+        }
+
+        // A block of dst's own, not yet extracted; copyPayload() shares instead when the
+        // resources are equal
+        static void clone(const Storage& src, Storage& dst, std::pmr::memory_resource* resource)
+        {
+            create(dst, block(src)->sentence, resource);
+        }
+
+        static void move(Storage& src, Storage& dst) noexcept
+        {
+            dst.heap = src.heap;
+            src.heap = nullptr;
+        }
+
+        static void moveTo(Storage& src, Storage& dst, std::pmr::memory_resource* resource)
+        {
+            clone(src, dst, resource);
+        }
+
+        static void destroy(Storage& s, std::pmr::memory_resource* resource) noexcept
+        {
+            Block* b = block(s);
+            if (b && b->refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            {
+                const std::size_t size = sizeof(Block) + b->sentence.size();
+                b->~Block();
+                resource->deallocate(b, size, alignof(Block));
+            }
+        }
+
+        static void write(const Storage& s, NMEAInsertionStream& ns)
+        {
+            writeFields(block(s)->sentence, ns);
+        }
+
+        // Always leaves deferred mode, extracting first if need be: the caller may be about
+        // to modify the payload. Fields that did not parse leave a default T, which only
+        // deserialize() gets to see: get<T>() and tryGet<T>() check before detaching.
+        static const Operations* detach(Storage& s, std::pmr::memory_resource* resource)
+        {
+            T* value = ptr(s);
+            Storage own;
+            if (!value)
+                Model<T>::create(own, T {}, resource);
+            else if (block(s)->refs.load(std::memory_order_acquire) == 1)
+                Model<T>::create(own, std::move(*value), resource);
+            else
+                Model<T>::create(own, *value, resource);
+            destroy(s, resource);
+            Model<T>::move(own, s);
+            return &Model<T>::operations;
+        }
+
+        // read is never called: deserialize() detaches first
+        static constexpr Operations operations {
+            typeId<T>(), &Model<T>::type, &clone, &move, &moveTo, &destroy, &write, nullptr,
+            true, nullptr, &detach, &decoded
+        };
+    };
+
+    // Out of line, where the stream classes are complete (AnyNMEAMessage.cpp). readSentence
+    // counts the deferred sentence's decode outcome and returns whether the fields parsed.
+    static bool readSentence(std::string_view sentence, void* value, void (*extract)(void*, NMEAExtractionStream&));
+    static void writeFields(std::string_view sentence, NMEAInsertionStream& ns);
+
+    template <class T>
+    T* payload() noexcept
+    {
+        return ops_->shared ? SharedModel<T>::ptr(storage_) : Model<T>::ptr(storage_);
+    }
+
+    // Extracts a deferred payload, so may throw whatever T's operator>> throws; nullptr if
+    // its fields do not parse
+    template <class T>
+    const T* payload() const
+    {
+        if (ops_->decoded)
+            return DeferredModel<T>::ptr(storage_);
+        return ops_->shared ? SharedModel<T>::ptr(storage_) : Model<T>::ptr(storage_);
+    }
+
+    // Extracts a deferred payload; false if its fields do not parse
+    bool isDecoded() const
+    {
+        return !ops_->decoded || ops_->decoded(storage_);
+    }
+
+    void checkDecoded() const
+    {
+        if (!isDecoded()) NMEA_THROW(std::runtime_error("AnyNMEAMessage payload fields do not parse"));
+    }
+
+    void detach()
+    {
+        if (ops_->detach)
+            ops_ = ops_->detach(storage_, resource_);
+    }
+
+    template <class T>
+    void emplace(T&& value)
+    {
+        using U = std::decay_t<T>;
+        Model<U>::create(storage_, std::forward<T>(value), resource_);
+        ops_ = &Model<U>::operations;
+    }
+
+    void takePayload(AnyNMEAMessage& o) noexcept
+    {
+        if (o.ops_)
+        {
+            o.ops_->move(o.storage_, storage_);
+            ops_   = o.ops_;
+            o.ops_ = nullptr;
+        }
+    }
+
+    // Whether memory from o's resource can be freed through ours, and so handed over
+    bool hasEqualResource(const AnyNMEAMessage& o) const noexcept
+    {
+        return resource_ == o.resource_ || resource_->is_equal(*o.resource_);
+    }
+
+    void copyPayload(const AnyNMEAMessage& o)
+    {
+        if (!o.ops_)
+            return;
+
+        if (o.ops_->shared && hasEqualResource(o))
+        {
+            static_cast<SharedCount*>(o.storage_.heap)->refs.fetch_add(1, std::memory_order_relaxed);
+            storage_.heap = o.storage_.heap;
+        }
+        else
+            o.ops_->clone(o.storage_, storage_, resource_);
+        ops_ = o.ops_;
+    }
+
+    // Steals o's payload when both resources can free each other's memory, else moves it
+    // into a fresh allocation from ours. Either way o ends up empty.
+    void movePayload(AnyNMEAMessage& o)
+    {
+        if (hasEqualResource(o))
+            takePayload(o);
+        else if (o.ops_)
+        {
+            o.ops_->moveTo(o.storage_, storage_, resource_);
+            ops_ = o.ops_;
+            o.reset();
+        }
+    }
+
+    void reset() noexcept
+    {
+        if (ops_)
+        {
+            ops_->destroy(storage_, resource_);
+            ops_ = nullptr;
+        }
+    }
+
     template <class T>
     void checkType() const
     {
-        if (!self_ || self_->type() != typeid(T)) throw std::bad_cast();
+        if (!isType<T>()) NMEA_THROW(std::bad_cast());
     }
 
-    void validateTalkerHeader() const
+    void validateTalkerHeader(std::string_view talker, std::string_view messageName) const
     {
-        if (talker_.size() != 2) throw std::runtime_error("talker must be 2 chars");
-        if (messageName_.size() != 3) throw std::runtime_error("messageName must be 3 chars");
+        if (talker.size() != 2 || !header_.isTalkerValid()) NMEA_THROW(std::runtime_error("talker must be 2 chars"));
+        if (messageName.size() != 3 || !header_.isNameValid()) NMEA_THROW(std::runtime_error("messageName must be 3 chars"));
     }
 
 private:
-    std::unique_ptr<Concept> self_ { nullptr };
-    std::string talker_;
-    std::string messageName_;
+    Storage storage_;
+    const Operations* ops_ { nullptr };
+    NMEAHeader header_;
+    std::pmr::memory_resource* resource_ { std::pmr::get_default_resource() };
     std::uint8_t checksum_ = 0; // optional cache from your streams
     std::size_t  size_     = 0; // optional cache from your streams
 };
@@ -0,0 +1,22 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2025 Mark Wilson
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+//  https://www.boost.org/LICENSE_1_0.txt)
+//-----------------------------------------------------------------------------
+#include "ExampleMessages.h"
+
+using namespace std;
+
+ostream &operator<<(ostream &str, const GGAMessage &msg)
+{
+    str << "GGA: i = " << msg.i << ", d = " << msg.d << ", s = " << msg.s;
+    return str;
+}
+
+ostream &operator<<(ostream &str, const RMCMessage &msg)
+{
+    str << "RMC: d = " << msg.d << ", i = " << msg.i;
+    return str;
+}
@@ -0,0 +1,58 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2025 Mark Wilson
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+//  https://www.boost.org/LICENSE_1_0.txt)
+//-----------------------------------------------------------------------------
+#pragma once
+
+#include <ostream>
+#include <string>
+
+#include "AnyNMEAMessage.h"
+#include "NMEASchema.h"
+
+//
+// Strawmen NMEA messages to keep things simple. Shared by the demo and the benchmarks.
+// Their NMEA stream operators and message names come from the schemas below.
+//
+struct GGAMessage
+{
+    int i{42};
+    double d{123.456};
+    std::string s{"STRING"};
+};
+
+std::ostream &operator<<(std::ostream &str, const GGAMessage &msg);
+
+
+struct RMCMessage
+{
+    double d{456.789};
+    int i{105};
+};
+
+std::ostream &operator<<(std::ostream &str, const RMCMessage &msg);
+
+
+template<>
+struct NMEASchema<GGAMessage> : NMEASchemaDefinition<GGAMessage,
+    NMEAField<&GGAMessage::i, 11>,
+    NMEAField<&GGAMessage::d, 16, NMEAFieldFormat::Fixed, 6>,
+    NMEAField<&GGAMessage::s, 16>>
+{
+    static constexpr NMEAMessageName messageName() { return "GGA"; }
+};
+
+template<>
+struct NMEASchema<RMCMessage> : NMEASchemaDefinition<RMCMessage,
+    NMEAField<&RMCMessage::i, 11>,
+    NMEAField<&RMCMessage::d, 16, NMEAFieldFormat::Fixed, 6>>
+{
+    static constexpr NMEAMessageName messageName() { return "RMC"; }
+};
+
+// Both strawmen are small enough to live inside AnyNMEAMessage without a heap allocation.
+static_assert(AnyNMEAMessage::storesInline<GGAMessage>(), "GGAMessage should be stored inline");
+static_assert(AnyNMEAMessage::storesInline<RMCMessage>(), "RMCMessage should be stored inline");
@@ -14,7 +14,7 @@ MutableBuffer::MutableBuffer(char* buffer, std::size_t size) :
 
 char* MutableBuffer::data() const { return mBuffer; }
 
-std::size_t MutableBuffer::size()  { return mSize; }
+std::size_t MutableBuffer::size() const { return mSize; }
 
 MutableBuffer buffer(char* buffer, std::size_t size)
 {
@@ -23,7 +23,7 @@ public:
 
     char* data() const;
 
-    std::size_t size();
+    std::size_t size() const;
 
 private:
     char* mBuffer;
@@ -0,0 +1,91 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2025 Mark Wilson
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+//  https://www.boost.org/LICENSE_1_0.txt)
+//-----------------------------------------------------------------------------
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "AnyNMEAMessage.h"
+#include "ImmutableBuffer.h"
+#include "NMEACommon.h"
+#include "NMEAExtractionStream.h"
+#include "NMEAQuarantineRing.h"
+#include "NMEAThreadPool.h"
+
+/**
+ * @brief Knobs for decodeNMEABatch().
+ */
+struct NMEABatchOptions
+{
+    /// Workers to spread the batch over; nullptr decodes on the calling thread.
+    NMEAThreadPool* pool {nullptr};
+
+    /// Sentences per work item. Small grains balance better, large ones steal less often.
+    std::size_t grainSize {256};
+
+    /// If set, every sentence that does not decode is copied here with its status.
+    NMEAQuarantineRing* quarantine {nullptr};
+};
+
+/**
+ * @brief decodeNMEABatch decodes input[0..count) into output[0..count) in input order.
+ *
+ * output must already hold count messages; each is overwritten (left empty if its sentence
+ * does not decode), allocating from its own memory resource. status, if not nullptr, also
+ * has room for count entries and receives why each sentence did or did not decode. A
+ * sentence whose fields do not parse, or a type whose extraction throws, is reported as
+ * DecodeFailed for that index instead of aborting the batch.
+ *
+ * Registry is an NMEAMessageRegistry<...> instantiation.
+ * @return How many sentences decoded.
+ */
+template <class Registry>
+std::size_t decodeNMEABatch(const ImmutableBuffer* input, std::size_t count, AnyNMEAMessage* output,
+                            NMEADecodeStatus* status, const NMEABatchOptions& options = NMEABatchOptions())
+{
+    std::atomic<std::size_t> decoded {0};
+
+    auto decodeRange = [&](std::size_t begin, std::size_t end) {
+        NMEAExtractionStream stream;
+        std::size_t ok = 0;
+        for (std::size_t i = begin; i < end; ++i)
+        {
+            stream.rebind(input[i]);
+            const NMEADecodeStatus result = Registry::tryDecode(stream, output[i]);
+            if (result != NMEADecodeStatus::Ok && options.quarantine)
+                options.quarantine->push(std::string_view(input[i].data(), input[i].size()), result);
+
+            ok += result == NMEADecodeStatus::Ok;
+            if (status)
+                status[i] = result;
+        }
+        decoded.fetch_add(ok, std::memory_order_relaxed);
+    };
+
+    if (options.pool)
+        options.pool->parallelFor(count, options.grainSize, decodeRange);
+    else
+        decodeRange(0, count);
+
+    return decoded.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief decodeNMEABatch resizes output and status to input.size() and decodes into them.
+ */
+template <class Registry>
+std::size_t decodeNMEABatch(const std::vector<ImmutableBuffer>& input, std::vector<AnyNMEAMessage>& output,
+                            std::vector<NMEADecodeStatus>& status,
+                            const NMEABatchOptions& options = NMEABatchOptions())
+{
+    output.resize(input.size());
+    status.resize(input.size());
+    return decodeNMEABatch<Registry>(input.data(), input.size(), output.data(), status.data(), options);
+}
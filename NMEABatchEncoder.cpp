@@ -0,0 +1,60 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2025 Mark Wilson
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+//  https://www.boost.org/LICENSE_1_0.txt)
+//-----------------------------------------------------------------------------
+#include <stdexcept>
+
+#include "AnyNMEAMessage.h"
+#include "NMEABatchEncoder.h"
+#include "NMEACommon.h"
+#include "NMEAExceptions.h"
+#include "NMEAInsertionStream.h"
+
+NMEABatchEncoder::NMEABatchEncoder(const MutableBuffer &buffer) :
+    mBegin(buffer.data()),
+    mCapacity(buffer.size())
+{
+    // Enough entries for a buffer full of typical sentences, so refills do not allocate
+    mSentences.reserve(mCapacity / (NMEAMaxSentenceLength / 2) + 1);
+}
+
+bool NMEABatchEncoder::append(const AnyNMEAMessage &message)
+{
+    // The window is the unused tail; whatever the stream writes there past a failure is
+    // simply not counted, which is all the rollback there is to do.
+    MutableBuffer window(mBegin + mUsed, mCapacity - mUsed);
+    NMEAInsertionStream stream(window, message.getHeader());
+    message.serialize(stream);
+
+    // Types that leave the trailer to the caller still get a whole sentence
+    if ( !stream.isComplete() && !stream.overflowed() )
+        stream << NMEAInsertionStream::EndMsg();
+
+    if ( !stream.isComplete() )
+        return false;
+
+    mSentences.push_back(NMEAEncodedSentence {mUsed, stream.size()});
+    mUsed += stream.size();
+    return true;
+}
+
+std::size_t NMEABatchEncoder::encode(const AnyNMEAMessage *messages, std::size_t count)
+{
+    std::size_t encoded = 0;
+    while ( encoded < count && append(messages[encoded]) )
+        ++encoded;
+
+    if ( encoded < count && empty() )
+        NMEA_THROW(std::runtime_error("AnyNMEAMessage does not fit in an empty NMEABatchEncoder buffer"));
+
+    return encoded;
+}
+
+void NMEABatchEncoder::clear()
+{
+    mUsed = 0;
+    mSentences.clear();
+}
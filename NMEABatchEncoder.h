@@ -0,0 +1,89 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2025 Mark Wilson
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+//  https://www.boost.org/LICENSE_1_0.txt)
+//-----------------------------------------------------------------------------
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
+#include "MutableBuffer.h"
+
+class AnyNMEAMessage;
+
+/**
+ * @brief Where one encoded sentence sits in an NMEABatchEncoder's buffer.
+ */
+struct NMEAEncodedSentence
+{
+    std::size_t offset;
+    std::size_t length;
+};
+
+/**
+ * @brief The NMEABatchEncoder class packs many messages back to back into one MutableBuffer.
+ *
+ * Each sentence is written straight after the previous one, "*HH\r\n" included, and its
+ * offset and length are recorded so the batch can go out with a single write() of data()
+ * or a writev() of one iovec per sentence. A message that does not fit is rolled back, so
+ * the buffer only ever holds whole sentences; send what is there, clear() and carry on:
+ *
+ * @code
+ * NMEABatchEncoder encoder(buffer(storage.data(), storage.size()));
+ * for (std::size_t done = 0; done < messages.size(); )
+ * {
+ *     done += encoder.encode(messages.data() + done, messages.size() - done);
+ *     ::write(fd, encoder.data(), encoder.size());
+ *     encoder.clear();
+ * }
+ * @endcode
+ */
+class NMEABatchEncoder
+{
+public:
+    explicit NMEABatchEncoder(const MutableBuffer& buffer);
+
+    /**
+     * @brief append encodes one message after the ones already in the buffer.
+     * @return false, leaving the buffer as it was, if the sentence does not fit.
+     * @throws std::runtime_error if message is empty.
+     */
+    bool append(const AnyNMEAMessage& message);
+
+    /**
+     * @brief encode appends messages[0..count) until one does not fit.
+     * @return How many were encoded; resume from there after clear().
+     * @throws std::runtime_error if a message does not fit even an empty buffer.
+     */
+    std::size_t encode(const AnyNMEAMessage* messages, std::size_t count);
+
+    /// @return Offset and length of every sentence in the buffer, in encode order.
+    const std::vector<NMEAEncodedSentence>& sentences() const { return mSentences; }
+
+    std::string_view sentence(std::size_t idx) const
+    {
+        return std::string_view(mBegin + mSentences[idx].offset, mSentences[idx].length);
+    }
+
+    const char* data() const { return mBegin; }
+
+    /// @return Bytes used by the encoded sentences.
+    std::size_t size() const { return mUsed; }
+
+    std::size_t capacity() const { return mCapacity; }
+
+    bool empty() const { return mSentences.empty(); }
+
+    /// @brief clear forgets every sentence so the buffer can be refilled.
+    void clear();
+
+private:
+    char* mBegin;
+    std::size_t mCapacity;
+    std::size_t mUsed {0};
+    std::vector<NMEAEncodedSentence> mSentences;
+};
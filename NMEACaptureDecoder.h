@@ -0,0 +1,206 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2025 Mark Wilson
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+//  https://www.boost.org/LICENSE_1_0.txt)
+//-----------------------------------------------------------------------------
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "AnyNMEAMessage.h"
+#include "ImmutableBuffer.h"
+#include "NMEACaptureFile.h"
+#include "NMEACommon.h"
+#include "NMEAExceptions.h"
+#include "NMEAExtractionStream.h"
+#include "NMEAQuarantineRing.h"
+
+/**
+ * @brief Totals for one decode pass over a capture file.
+ */
+struct NMEACaptureStats
+{
+    std::size_t sentences {0};  ///< non-empty lines seen
+    std::size_t decoded {0};    ///< lines turned into a message
+    std::size_t rejected {0};   ///< bad framing or checksum, or a name the registry does not know
+
+    NMEACaptureStats& operator+=(const NMEACaptureStats& other)
+    {
+        sentences += other.sentences;
+        decoded += other.decoded;
+        rejected += other.rejected;
+        return *this;
+    }
+};
+
+/**
+ * @brief The NMEACaptureDecoder class decodes a mapped capture file on several threads.
+ *
+ * The file is cut into sentence-aligned chunks (a few per thread so a slow chunk does not
+ * stall the pass). Workers claim chunks from a shared counter and decode each line in place
+ * with one NMEAExtractionStream per worker, so no sentence is copied out of the mapping.
+ * Registry is an NMEAMessageRegistry<...> instantiation.
+ *
+ * @code
+ * NMEACaptureFile file("mission.nmea");
+ * NMEACaptureDecoder<NMEAMessageRegistry<GGAMessage, RMCMessage>> decoder(4);
+ * std::vector<AnyNMEAMessage> messages = decoder.decodeOrdered(file);
+ * @endcode
+ */
+template <class Registry>
+class NMEACaptureDecoder
+{
+public:
+    static constexpr std::size_t ChunksPerThread = 8;
+
+    /// @param threads Worker count; 0 means std::thread::hardware_concurrency().
+    explicit NMEACaptureDecoder(unsigned threads = 0) :
+        mThreads(threads != 0 ? threads : std::max(1u, std::thread::hardware_concurrency()))
+    {
+    }
+
+    unsigned threads() const { return mThreads; }
+
+    /// @return The totals of the last decodeOrdered()/decodeUnordered() call.
+    const NMEACaptureStats& stats() const { return mStats; }
+
+    /// @brief setQuarantine makes later passes copy every rejected line into quarantine.
+    void setQuarantine(NMEAQuarantineRing* quarantine) { mQuarantine = quarantine; }
+
+    /**
+     * @brief decodeOrdered decodes the whole file.
+     * @return The messages in the order their sentences appear in the file.
+     */
+    std::vector<AnyNMEAMessage> decodeOrdered(const NMEACaptureFile& file)
+    {
+        const std::vector<std::string_view> chunks = file.chunks(std::size_t{mThreads} * ChunksPerThread);
+
+        // Every line gets a slot up front so workers can move straight into the result;
+        // lines that do not decode leave an empty message behind that is squeezed out below.
+        std::vector<std::size_t> firstSlot(chunks.size() + 1, 0);
+        for (std::size_t i = 0; i < chunks.size(); ++i)
+            firstSlot[i + 1] = firstSlot[i] + lineCount(chunks[i]);
+
+        std::vector<AnyNMEAMessage> result(firstSlot.back());
+        std::vector<std::size_t> nextSlot(firstSlot.begin(), firstSlot.end() - 1);
+
+        run(chunks, [&result, &nextSlot](std::size_t chunk, AnyNMEAMessage&& message) {
+            result[nextSlot[chunk]++] = std::move(message);
+        });
+
+        if (mStats.decoded != result.size())
+            result.erase(std::remove_if(result.begin(), result.end(),
+                                        [](const AnyNMEAMessage& m) { return m.isEmpty(); }),
+                         result.end());
+        return result;
+    }
+
+    /**
+     * @brief decodeUnordered hands each message to onMessage(AnyNMEAMessage&&) as soon as it
+     * is decoded. onMessage is called concurrently from the worker threads and must be
+     * thread safe; messages of one chunk arrive in file order, chunks interleave arbitrarily.
+     */
+    template <class F>
+    void decodeUnordered(const NMEACaptureFile& file, F&& onMessage)
+    {
+        const std::vector<std::string_view> chunks = file.chunks(std::size_t{mThreads} * ChunksPerThread);
+        run(chunks, [&onMessage](std::size_t, AnyNMEAMessage&& message) {
+            onMessage(std::move(message));
+        });
+    }
+
+private:
+    unsigned mThreads;
+    NMEACaptureStats mStats;
+    NMEAQuarantineRing* mQuarantine {nullptr};
+
+    /// Upper bound on the sentences forEachNMEALine() can produce from text.
+    static std::size_t lineCount(std::string_view text)
+    {
+        return static_cast<std::size_t>(std::count(text.begin(), text.end(), '\n')) +
+               (!text.empty() && text.back() != '\n');
+    }
+
+    template <class Sink>
+    static NMEACaptureStats decodeChunk(std::size_t chunk, std::string_view text, NMEAExtractionStream& stream,
+                                        NMEAQuarantineRing* quarantine, Sink& sink)
+    {
+        NMEACaptureStats stats;
+        forEachNMEALine(text, [&](std::string_view line) {
+            ++stats.sentences;
+            stream.rebind(ImmutableBuffer(line.data(), line.size()));
+
+            NMEADecodeStatus status;
+            AnyNMEAMessage message = Registry::decode(stream, status);
+            if (status != NMEADecodeStatus::Ok)
+            {
+                ++stats.rejected;
+                if (quarantine)
+                    quarantine->push(line, status);
+                return;
+            }
+
+            ++stats.decoded;
+            sink(chunk, std::move(message));
+        });
+        return stats;
+    }
+
+    template <class Sink>
+    void run(const std::vector<std::string_view>& chunks, Sink sink)
+    {
+        mStats = NMEACaptureStats();
+
+        const unsigned workers = static_cast<unsigned>(std::min<std::size_t>(mThreads, chunks.size()));
+        if (workers <= 1)
+        {
+            NMEAExtractionStream stream;
+            for (std::size_t i = 0; i < chunks.size(); ++i)
+                mStats += decodeChunk(i, chunks[i], stream, mQuarantine, sink);
+            return;
+        }
+
+        std::atomic<std::size_t> nextChunk {0};
+        std::vector<NMEACaptureStats> stats(workers);
+        std::vector<std::exception_ptr> errors(workers);
+        std::vector<std::thread> pool;
+        pool.reserve(workers);
+
+        for (unsigned w = 0; w < workers; ++w)
+        {
+            pool.emplace_back([&, w] {
+                NMEA_TRY
+                {
+                    NMEAExtractionStream stream;
+                    for (std::size_t i = nextChunk.fetch_add(1, std::memory_order_relaxed); i < chunks.size();
+                         i = nextChunk.fetch_add(1, std::memory_order_relaxed))
+                        stats[w] += decodeChunk(i, chunks[i], stream, mQuarantine, sink);
+                }
+                NMEA_CATCH_ALL
+                {
+                    errors[w] = std::current_exception();
+                    nextChunk.store(chunks.size(), std::memory_order_relaxed);
+                }
+            });
+        }
+
+        for (auto& thread : pool)
+            thread.join();
+
+        for (unsigned w = 0; w < workers; ++w)
+        {
+            if (errors[w])
+                std::rethrow_exception(errors[w]);
+            mStats += stats[w];
+        }
+    }
+};
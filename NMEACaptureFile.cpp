@@ -0,0 +1,106 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2025 Mark Wilson
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+//  https://www.boost.org/LICENSE_1_0.txt)
+//-----------------------------------------------------------------------------
+#include <algorithm>
+#include <cerrno>
+#include <system_error>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "NMEACaptureFile.h"
+#include "NMEAExceptions.h"
+
+NMEACaptureFile::NMEACaptureFile(const std::string &path)
+{
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if ( fd < 0 )
+        NMEA_THROW(std::system_error(errno, std::generic_category(), "open " + path));
+
+    struct stat st;
+    if ( ::fstat(fd, &st) != 0 )
+    {
+        int err = errno;
+        ::close(fd);
+        NMEA_THROW(std::system_error(err, std::generic_category(), "fstat " + path));
+    }
+
+    mSize = static_cast<std::size_t>(st.st_size);
+
+    // mmap refuses zero length mappings; an empty file is simply empty contents
+    if ( mSize > 0 )
+    {
+        void* p = ::mmap(nullptr, mSize, PROT_READ, MAP_PRIVATE, fd, 0);
+        if ( p == MAP_FAILED )
+        {
+            int err = errno;
+            ::close(fd);
+            NMEA_THROW(std::system_error(err, std::generic_category(), "mmap " + path));
+        }
+        ::madvise(p, mSize, MADV_SEQUENTIAL);
+        mData = static_cast<const char*>(p);
+    }
+
+    ::close(fd);
+}
+
+NMEACaptureFile::~NMEACaptureFile()
+{
+    unmap();
+}
+
+NMEACaptureFile::NMEACaptureFile(NMEACaptureFile &&other) noexcept :
+    mData(std::exchange(other.mData, nullptr)),
+    mSize(std::exchange(other.mSize, 0))
+{
+}
+
+NMEACaptureFile &NMEACaptureFile::operator=(NMEACaptureFile &&other) noexcept
+{
+    if ( this != &other )
+    {
+        unmap();
+        mData = std::exchange(other.mData, nullptr);
+        mSize = std::exchange(other.mSize, 0);
+    }
+    return *this;
+}
+
+void NMEACaptureFile::unmap() noexcept
+{
+    if ( mData )
+        ::munmap(const_cast<char*>(mData), mSize);
+    mData = nullptr;
+    mSize = 0;
+}
+
+std::vector<std::string_view> NMEACaptureFile::chunks(std::size_t count) const
+{
+    std::vector<std::string_view> result;
+    if ( count == 0 )
+        count = 1;
+
+    std::string_view all = contents();
+    std::size_t start = 0;
+
+    for (std::size_t i = 1; i <= count && start < all.size(); ++i)
+    {
+        std::size_t end = all.size();
+        if ( i < count )
+        {
+            std::size_t newline = all.find('\n', std::max(start, all.size() / count * i));
+            end = newline == std::string_view::npos ? all.size() : newline + 1;
+        }
+        result.push_back(all.substr(start, end - start));
+        start = end;
+    }
+
+    return result;
+}
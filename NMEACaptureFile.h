@@ -0,0 +1,69 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2025 Mark Wilson
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+//  https://www.boost.org/LICENSE_1_0.txt)
+//-----------------------------------------------------------------------------
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief The NMEACaptureFile class maps a recorded NMEA log read-only into memory, so
+ * sentences can be decoded straight out of the page cache without read()/getline copies.
+ * POSIX only (mmap). Construction throws std::system_error if the file cannot be mapped
+ * (aborts in builds without exceptions).
+ */
+class NMEACaptureFile
+{
+public:
+    explicit NMEACaptureFile(const std::string& path);
+
+    ~NMEACaptureFile();
+
+    NMEACaptureFile(const NMEACaptureFile&) = delete;
+    NMEACaptureFile& operator=(const NMEACaptureFile&) = delete;
+
+    NMEACaptureFile(NMEACaptureFile&& other) noexcept;
+    NMEACaptureFile& operator=(NMEACaptureFile&& other) noexcept;
+
+    std::string_view contents() const { return std::string_view(mData, mSize); }
+
+    std::size_t size() const { return mSize; }
+
+    /**
+     * @brief chunks splits the file into at most count pieces of roughly equal size. Every
+     * piece but the last ends just after a '\n', so no sentence straddles two pieces.
+     */
+    std::vector<std::string_view> chunks(std::size_t count) const;
+
+private:
+    const char* mData {nullptr};
+    std::size_t mSize {0};
+
+    void unmap() noexcept;
+};
+
+/**
+ * @brief forEachNMEALine calls onLine(std::string_view) for every line of text with the
+ * "\r\n" or "\n" terminator removed. Empty lines are skipped.
+ */
+template <class F>
+void forEachNMEALine(std::string_view text, F&& onLine)
+{
+    while (!text.empty())
+    {
+        std::size_t newline = text.find('\n');
+        std::string_view line = text.substr(0, newline);
+        text.remove_prefix(newline == std::string_view::npos ? text.size() : newline + 1);
+
+        if (!line.empty() && line.back() == '\r')
+            line.remove_suffix(1);
+        if (!line.empty())
+            onLine(line);
+    }
+}
@@ -0,0 +1,320 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2025 Mark Wilson
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+//  https://www.boost.org/LICENSE_1_0.txt)
+//-----------------------------------------------------------------------------
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "AnyNMEAMessage.h"
+#include "NMEAExceptions.h"
+#include "NMEAExtractionStream.h"
+#include "NMEASchema.h"
+
+/**
+ * @brief The NMEAColumnView class is a read-only, non-owning view of one column.
+ */
+template <class U>
+class NMEAColumnView
+{
+public:
+    NMEAColumnView(const U* data, std::size_t size) : mData(data), mSize(size) {}
+
+    const U* data() const { return mData; }
+    std::size_t size() const { return mSize; }
+    bool empty() const { return mSize == 0; }
+
+    const U* begin() const { return mData; }
+    const U* end() const { return mData + mSize; }
+
+    const U& operator[](std::size_t idx) const { return mData[idx]; }
+
+private:
+    const U* mData;
+    std::size_t mSize;
+};
+
+/**
+ * @brief The NMEAAlignedColumn class is an append-only array whose storage starts on a
+ * 64 byte boundary and whose capacity is a whole number of 64 byte lines, so SIMD loops can
+ * use aligned loads and read a full vector past size() without leaving the allocation.
+ */
+template <class U>
+class NMEAAlignedColumn
+{
+public:
+    static constexpr std::size_t Alignment = 64;
+
+    NMEAAlignedColumn() = default;
+
+    NMEAAlignedColumn(const NMEAAlignedColumn&) = delete;
+    NMEAAlignedColumn& operator=(const NMEAAlignedColumn&) = delete;
+
+    NMEAAlignedColumn(NMEAAlignedColumn&& o) noexcept :
+        mData(std::exchange(o.mData, nullptr)),
+        mSize(std::exchange(o.mSize, 0)),
+        mCapacity(std::exchange(o.mCapacity, 0))
+    {
+    }
+
+    NMEAAlignedColumn& operator=(NMEAAlignedColumn&& o) noexcept
+    {
+        if (this != &o)
+        {
+            release();
+            mData = std::exchange(o.mData, nullptr);
+            mSize = std::exchange(o.mSize, 0);
+            mCapacity = std::exchange(o.mCapacity, 0);
+        }
+        return *this;
+    }
+
+    ~NMEAAlignedColumn() { release(); }
+
+    U* data() { return mData; }
+    const U* data() const { return mData; }
+    std::size_t size() const { return mSize; }
+    std::size_t capacity() const { return mCapacity; }
+
+    void reserve(std::size_t n)
+    {
+        if (n <= mCapacity)
+            return;
+
+        // Round the allocation up to whole cache lines
+        const std::size_t bytes = (n * sizeof(U) + Alignment - 1) / Alignment * Alignment;
+        const std::size_t capacity = bytes / sizeof(U);
+
+        U* fresh = static_cast<U*>(::operator new(bytes, std::align_val_t {Alignment}));
+        if constexpr (std::is_nothrow_move_constructible<U>::value)
+            std::uninitialized_move(mData, mData + mSize, fresh);
+        else
+        {
+            NMEA_TRY
+            {
+                std::uninitialized_copy(mData, mData + mSize, fresh);
+            }
+            NMEA_CATCH_ALL
+            {
+                ::operator delete(fresh, std::align_val_t {Alignment});
+                NMEA_RETHROW;
+            }
+        }
+
+        const std::size_t size = mSize;
+        release();
+        mData = fresh;
+        mSize = size;
+        mCapacity = capacity;
+    }
+
+    /// @brief emplaceBack appends a value initialized element and returns it.
+    U& emplaceBack()
+    {
+        if (mSize == mCapacity)
+            reserve(std::max<std::size_t>(mCapacity * 2, Alignment / sizeof(U) + 1));
+        ::new (static_cast<void*>(mData + mSize)) U();
+        return mData[mSize++];
+    }
+
+    /// @brief truncate destroys every element from n on.
+    void truncate(std::size_t n) noexcept
+    {
+        if constexpr (!std::is_trivially_destructible<U>::value)
+            std::destroy(mData + std::min(n, mSize), mData + mSize);
+        mSize = std::min(n, mSize);
+    }
+
+private:
+    U* mData {nullptr};
+    std::size_t mSize {0};
+    std::size_t mCapacity {0};
+
+    void release() noexcept
+    {
+        truncate(0);
+        if (mData)
+            ::operator delete(mData, std::align_val_t {Alignment});
+        mData = nullptr;
+        mCapacity = 0;
+    }
+};
+
+/**
+ * @brief The NMEAColumnStore class keeps decoded messages of one type as a struct of arrays:
+ * one NMEAAlignedColumn per listed data member, row i of every column belonging to the
+ * i-th message.
+ *
+ * Members are pointers to T's data members, any subset of them in any order. append() looks
+ * each one's field up in NMEASchema<T> and extracts the sentence straight into the columns
+ * without building a T first. Scanning one field then walks one dense array instead of
+ * striding over whole messages.
+ *
+ * @code
+ * NMEAColumnStore<GGAMessage, &GGAMessage::d, &GGAMessage::i> store;
+ * store.append(stream);
+ * for (double d : store.column<&GGAMessage::d>()) ...
+ * @endcode
+ */
+template <class T, auto... Members>
+class NMEAColumnStore
+{
+    template <class M>
+    struct MemberOf;
+
+    template <class C, class U>
+    struct MemberOf<U C::*>
+    {
+        using Class = C;
+        using Type = U;
+    };
+
+    template <auto Member>
+    struct Tag {};
+
+    static_assert(sizeof...(Members) > 0, "NMEAColumnStore needs at least one column");
+    static_assert((std::is_member_object_pointer<decltype(Members)>::value && ...),
+                  "NMEAColumnStore columns must be pointers to data members");
+    static_assert((std::is_same<typename MemberOf<decltype(Members)>::Class, T>::value && ...),
+                  "NMEAColumnStore columns must be members of T");
+
+public:
+    static constexpr std::size_t ColumnCount = sizeof...(Members);
+
+    /// The element type of column I.
+    template <std::size_t I>
+    using ColumnType = typename MemberOf<std::tuple_element_t<I, std::tuple<decltype(Members)...>>>::Type;
+
+    /// The index of Member among the columns.
+    template <auto Member>
+    static constexpr std::size_t indexOf()
+    {
+        constexpr bool matches[] = { std::is_same<Tag<Member>, Tag<Members>>::value... };
+        for (std::size_t i = 0; i < ColumnCount; ++i)
+            if (matches[i])
+                return i;
+        return ColumnCount;
+    }
+
+    std::size_t size() const { return std::get<0>(mColumns).size(); }
+
+    bool empty() const { return size() == 0; }
+
+    void reserve(std::size_t n)
+    {
+        std::apply([n](auto&... column) { (column.reserve(n), ...); }, mColumns);
+    }
+
+    void clear() { truncate(0); }
+
+    /**
+     * @brief append extracts the sentence in stream into a new row: each column from the
+     * field NMEASchema<T> places its member at, formatted as the schema says. Nothing is
+     * appended if the sentence is not framed, fails its checksum or is not a
+     * NMEATraits<T>::messageName() sentence. Needs an NMEASchema<T> listing every column.
+     * @return true if a row was appended; stream.good() tells whether every field parsed.
+     */
+    bool append(NMEAExtractionStream& stream)
+    {
+        using Schema = NMEASchema<T>;
+        static_assert(((Schema::template fieldIndex<Members>() != 0) && ...),
+                      "Every column appended from a sentence must be a field of NMEASchema<T>");
+
+        if (!stream.isChecksumValid() || stream.getHeader().name() != NMEATraits<T>::messageName())
+            return false;
+
+        stream.reset();
+        appendRow([&stream](auto& field, auto column) {
+            constexpr auto Member = member<decltype(column)::value>();
+            stream >> NMEAExtractionStream::Seek {Schema::template fieldIndex<Member>()};
+            Schema::template readField<Member>(stream, field);
+        });
+        return true;
+    }
+
+    /// @brief append copies the listed members of value into a new row.
+    void append(const T& value)
+    {
+        appendRow([&value](auto& field, auto column) { field = value.*member<decltype(column)::value>(); });
+    }
+
+    /// @return Row idx reassembled as a T; members without a column are value initialized.
+    T row(std::size_t idx) const
+    {
+        T value {};
+        assignRow(value, idx, std::index_sequence_for<decltype(Members)...>());
+        return value;
+    }
+
+    template <std::size_t I>
+    NMEAColumnView<ColumnType<I>> column() const
+    {
+        const auto& c = std::get<I>(mColumns);
+        return NMEAColumnView<ColumnType<I>>(c.data(), c.size());
+    }
+
+    template <auto Member, std::enable_if_t<std::is_member_object_pointer<decltype(Member)>::value, int> = 0>
+    auto column() const
+    {
+        static_assert(indexOf<Member>() < ColumnCount, "Member is not a column of this NMEAColumnStore");
+        return column<indexOf<Member>()>();
+    }
+
+    /// @return Column I's storage, 64 byte aligned, for handing to vectorized code as is.
+    template <std::size_t I>
+    const NMEAAlignedColumn<ColumnType<I>>& columnStorage() const { return std::get<I>(mColumns); }
+
+private:
+    std::tuple<NMEAAlignedColumn<typename MemberOf<decltype(Members)>::Type>...> mColumns;
+
+    template <std::size_t I>
+    static constexpr auto member() { return std::get<I>(std::make_tuple(Members...)); }
+
+    // fill(field, std::integral_constant<std::size_t, I>) is called once per column
+    template <class Fill>
+    void appendRow(Fill fill)
+    {
+        const std::size_t rows = size();
+        NMEA_TRY
+        {
+            fillColumns(fill, std::index_sequence_for<decltype(Members)...>());
+        }
+        NMEA_CATCH_ALL
+        {
+            truncate(rows);
+            NMEA_RETHROW;
+        }
+    }
+
+    template <class Fill, std::size_t... Is>
+    void fillColumns(Fill& fill, std::index_sequence<Is...>)
+    {
+        (fillColumn<Is>(fill), ...);
+    }
+
+    template <std::size_t I, class Fill>
+    void fillColumn(Fill& fill)
+    {
+        fill(std::get<I>(mColumns).emplaceBack(), std::integral_constant<std::size_t, I>());
+    }
+
+    template <std::size_t... Is>
+    void assignRow(T& value, std::size_t idx, std::index_sequence<Is...>) const
+    {
+        ((value.*member<Is>() = std::get<Is>(mColumns).data()[idx]), ...);
+    }
+
+    void truncate(std::size_t n) noexcept
+    {
+        std::apply([n](auto&... column) { (column.truncate(n), ...); }, mColumns);
+    }
+};
@@ -6,32 +6,138 @@
 //  https://www.boost.org/LICENSE_1_0.txt)
 //-----------------------------------------------------------------------------
 #include <string.h>
+#include <cstring>
 
+#include "ImmutableBuffer.h"
 #include "NMEACommon.h"
 #include "NMEAExtractionStream.h"
 
-int8_t calculateNMEAChecksum(char* nmeaMsg, char terminationCharacter)
+namespace {
+
+inline std::uint64_t load64(const char* p)
+{
+    std::uint64_t w;
+    std::memcpy(&w, p, sizeof(w));
+    return w;
+}
+
+inline bool isHeaderChar(char c)
+{
+    return (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9');
+}
+
+inline int hexValue(char c)
 {
-    unsigned char checkSum = 0;
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    return -1;
+}
+
+} // namespace
 
-    auto l = strlen(nmeaMsg);
+std::uint8_t xorNMEABytes(std::string_view data)
+{
+    const char* p = data.data();
+    std::size_t n = data.size();
 
-    for (std::size_t idx = 1; nmeaMsg[idx]!=terminationCharacter; idx++) // Index 1 is '$' and doesn't count in checksum
+    // Two independent accumulators keep the XORs from serializing on one register.
+    std::uint64_t a = 0;
+    std::uint64_t b = 0;
+    for (; n >= 16; p += 16, n -= 16)
+    {
+        a ^= load64(p);
+        b ^= load64(p + 8);
+    }
+    if (n >= 8)
     {
-        checkSum ^= nmeaMsg[idx];
+        a ^= load64(p);
+        p += 8;
+        n -= 8;
     }
 
+    a ^= b;
+    a ^= a >> 32;
+    a ^= a >> 16;
+    a ^= a >> 8;
+
+    std::uint8_t checkSum = static_cast<std::uint8_t>(a);
+    for (; n > 0; --n)
+        checkSum ^= static_cast<std::uint8_t>(*p++);
+
     return checkSum;
 }
 
-bool validateNMEAMessage(char *nmeaMsg)
+std::uint8_t calculateNMEAChecksum(std::string_view nmeaMsg)
+{
+    if (!nmeaMsg.empty() && nmeaMsg.front() == '$') // '$' doesn't count in checksum
+        nmeaMsg.remove_prefix(1);
+
+    std::size_t star = nmeaMsg.find('*');
+    if (star != std::string_view::npos)
+        nmeaMsg = nmeaMsg.substr(0, star);
+
+    return xorNMEABytes(nmeaMsg);
+}
+
+std::uint8_t calculateNMEAChecksum(const ImmutableBuffer& nmeaMsg)
+{
+    return calculateNMEAChecksum(std::string_view(nmeaMsg.data(), nmeaMsg.size()));
+}
+
+std::uint8_t calculateNMEAChecksum(const char* nmeaMsg, char terminationCharacter)
+{
+    const char* end = terminationCharacter ? strchr(nmeaMsg + 1, terminationCharacter) : nullptr;
+    std::size_t length = end ? static_cast<std::size_t>(end - nmeaMsg) : strlen(nmeaMsg);
+
+    // Index 0 is '$' and doesn't count in checksum
+    return length > 1 ? xorNMEABytes(std::string_view(nmeaMsg + 1, length - 1)) : 0;
+}
+
+bool validateNMEAMessage(std::string_view nmeaMsg)
 {
-    std::size_t l = strlen(nmeaMsg);
+    // "$TTMMM*hh\r\n" is the shortest possible sentence
+    constexpr std::size_t MinLength = 11;
+
+    const std::size_t l = nmeaMsg.size();
+    if ( l < MinLength || l > NMEAMaxSentenceLength )
+        return false;
 
     if ( nmeaMsg[0] != '$' )
         return false;
 
-    return true;
+    for (std::size_t idx = 1; idx <= 5; idx++)
+    {
+        if ( !isHeaderChar(nmeaMsg[idx]) )
+            return false;
+    }
+    if ( nmeaMsg[6] != ',' && nmeaMsg[6] != '*' )
+        return false;
+
+    if ( nmeaMsg[l - 2] != '\r' || nmeaMsg[l - 1] != '\n' || nmeaMsg[l - 5] != '*' )
+        return false;
+
+    int hi = hexValue(nmeaMsg[l - 4]);
+    int lo = hexValue(nmeaMsg[l - 3]);
+    if ( hi < 0 || lo < 0 )
+        return false;
+
+    // The checksummed payload must not contain another '*'
+    std::string_view payload = nmeaMsg.substr(1, l - 6);
+    if ( payload.find('*') != std::string_view::npos )
+        return false;
+
+    return xorNMEABytes(payload) == ((hi << 4) | lo);
+}
+
+bool validateNMEAMessage(const ImmutableBuffer& nmeaMsg)
+{
+    return validateNMEAMessage(std::string_view(nmeaMsg.data(), nmeaMsg.size()));
+}
+
+bool validateNMEAMessage(const char *nmeaMsg)
+{
+    return validateNMEAMessage(std::string_view(nmeaMsg));
 }
 
 NMEAExtractionStream &operator>>(NMEAExtractionStream &stream, messageResult_t &v)
@@ -98,6 +204,19 @@ std::ostream &operator<<(std::ostream &os, memoryClass_t v)
 }
 
 
+const char* toString(NMEADecodeStatus status)
+{
+    switch (status) {
+    case NMEADecodeStatus::Ok:           return "OK";
+    case NMEADecodeStatus::BadFraming:   return "BAD_FRAMING";
+    case NMEADecodeStatus::BadChecksum:  return "BAD_CHECKSUM";
+    case NMEADecodeStatus::BadHeader:    return "BAD_HEADER";
+    case NMEADecodeStatus::UnknownType:  return "UNKNOWN_TYPE";
+    case NMEADecodeStatus::DecodeFailed: return "DECODE_FAILED";
+    }
+    return "UNKNOWN_DECODE_STATUS";
+}
+
 std::string toString(messageResult_t mr)
 {
     switch (mr) {
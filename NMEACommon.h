@@ -8,11 +8,35 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <ostream>
+#include <cstddef>
 #include <cstdint>
 
+class ImmutableBuffer;
 class NMEAExtractionStream;
 
+/**
+ * @brief NMEAMaxSentenceLength is the longest sentence NMEA 0183 allows, from '$' to the
+ * terminating '\n' inclusive.
+ */
+constexpr std::size_t NMEAMaxSentenceLength = 82;
+
+/**
+ * @brief The NMEADecodeStatus enum is the outcome of turning one raw sentence into a message.
+ */
+enum class NMEADecodeStatus : std::uint8_t
+{
+    Ok = 0,
+    BadFraming,   ///< Not "$...*hh", or more fields than NMEAExtractionStream::MaxFields
+    BadChecksum,  ///< Framed, but "hh" does not match the payload
+    BadHeader,    ///< The first field is not a 2 character talker and 3 character name
+    UnknownType,  ///< The message name is not registered
+    DecodeFailed  ///< A payload field did not parse, or the type's extraction operator threw
+};
+
+const char* toString(NMEADecodeStatus status);
+
 enum class messageResult_t : std::uint8_t {
     NACK = 0,
     ACK = 1,
@@ -36,23 +60,43 @@ std::string toString(messageResult_t mr);
 
 std::string toString(memoryClass_t mc);
 
+/**
+ * @brief xorNMEABytes XORs every byte of data together, 16 bytes at a time, and folds the
+ * result down to one byte. Reads exactly data.size() bytes; no terminator is needed.
+ */
+std::uint8_t xorNMEABytes(std::string_view data);
+
+/**
+ * @brief calculateNMEAChecksum calculates the checksum of a sentence: the XOR of every byte
+ * after the leading '$' (if present) up to, not including, the first '*' (or the end).
+ *
+ * @param nmeaMsg "$AABBB,f,f,f", "$AABBB,f,f,f*hh\r\n" or just the payload "AABBB,f,f,f"
+ * @return The checksum of the NMEA sentence
+ */
+std::uint8_t calculateNMEAChecksum(std::string_view nmeaMsg);
+
+std::uint8_t calculateNMEAChecksum(const ImmutableBuffer& nmeaMsg);
+
 /**
  * @brief calculateNMEAChecksum calculates checksum from after '$' (index 1)
- * to the last character. Assumes that nmeaMsg is $AABBB,f,f,f.
+ * up to terminationCharacter. Assumes that nmeaMsg is $AABBB,f,f,f.
  *
  * @param NmeaSentence
+ * @param terminationCharacter Character that ends the checksummed part, NUL by default.
+ * If it is not found the checksum runs to the terminating NUL.
  * @return The checksum of the NMEA sentence
- *
- * @todo Make this function more robust, could easily crash depending on
- * message and termination character.
  */
-std::int8_t calculateNMEAChecksum(char *nmeaMsg, char terminationCharacter=0);
+std::uint8_t calculateNMEAChecksum(const char *nmeaMsg, char terminationCharacter=0);
 
 /**
  * @brief validateNMEAMessage
  * @param nmeaMsg
- * @return true if starts with "$TTMMM", has correct checksum,
- * and last two characters are "\r\n". Returns false if any are
- * incorrect.
+ * @return true if starts with "$TTMMM" (upper case letters or digits, followed by ',' or '*'),
+ * is no longer than NMEAMaxSentenceLength, has a correct "*hh" checksum, and last two
+ * characters are "\r\n". Returns false if any are incorrect.
  */
-bool validateNMEAMessage(char* nmeaMsg);
+bool validateNMEAMessage(std::string_view nmeaMsg);
+
+bool validateNMEAMessage(const ImmutableBuffer& nmeaMsg);
+
+bool validateNMEAMessage(const char* nmeaMsg);
@@ -0,0 +1,280 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2025 Mark Wilson
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+//  https://www.boost.org/LICENSE_1_0.txt)
+//-----------------------------------------------------------------------------
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <map>
+#include <memory>
+#include <mutex>
+
+#include "NMEADecodeStats.h"
+
+namespace {
+
+using Counter = std::atomic<std::uint64_t>;
+
+// Only the owning thread writes a counter, so a relaxed load and store is enough: readers
+// never see a torn value, and there is no locked read-modify-write on the hot path.
+inline void increment(Counter& counter)
+{
+    counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+}
+
+struct NameSlot
+{
+    std::atomic<std::uint32_t> code {0};
+    Counter count {0};
+};
+
+// One per thread. The alignment keeps each block, and so each thread's writes, on cache
+// lines of its own; the groups inside are split so the frequently written status counters
+// do not share a line with the name table.
+struct alignas(64) ThreadCounters
+{
+    std::array<Counter, NMEADecodeStatusCount> status {};
+    Counter otherMessages {0};
+
+    alignas(64) std::array<NameSlot, NMEAMaxNamesPerThread> names {};
+
+    alignas(64) std::array<std::array<Counter, NMEALatencyHistogram::Buckets>, NMEALatencyStageCount> latency {};
+
+    // Set while a live thread owns the block; blocks of exited threads are handed to new ones
+    bool inUse {false};
+};
+
+struct StatsRegistry
+{
+    std::mutex mutex;
+    std::vector<std::unique_ptr<ThreadCounters>> blocks;
+};
+
+std::atomic<bool> latencyHistogramsEnabled {false};
+
+StatsRegistry& registry()
+{
+    // Never destroyed: threads may still release their block during static destruction
+    static StatsRegistry* instance = new StatsRegistry;
+    return *instance;
+}
+
+// Leases a block for the lifetime of the calling thread
+class ThreadLease
+{
+public:
+    ThreadLease()
+    {
+        StatsRegistry& r = registry();
+        std::lock_guard<std::mutex> lock(r.mutex);
+        for (auto& block : r.blocks)
+            if (!block->inUse)
+            {
+                mCounters = block.get();
+                break;
+            }
+
+        if (!mCounters)
+        {
+            r.blocks.push_back(std::make_unique<ThreadCounters>());
+            mCounters = r.blocks.back().get();
+        }
+        mCounters->inUse = true;
+    }
+
+    ~ThreadLease()
+    {
+        std::lock_guard<std::mutex> lock(registry().mutex);
+        mCounters->inUse = false;
+    }
+
+    ThreadLease(const ThreadLease&) = delete;
+    ThreadLease& operator=(const ThreadLease&) = delete;
+
+    ThreadCounters& counters() { return *mCounters; }
+
+private:
+    ThreadCounters* mCounters {nullptr};
+};
+
+ThreadCounters& localCounters()
+{
+    thread_local ThreadLease lease;
+    return lease.counters();
+}
+
+void countName(ThreadCounters& counters, NMEAMessageName name)
+{
+    const std::uint32_t code = name.code();
+
+    // Open addressing; only this thread inserts, so claiming an empty slot needs no CAS
+    std::size_t slot = (code * 0x9E3779B1u) >> 26;
+    for (std::size_t probe = 0; probe < NMEAMaxNamesPerThread; ++probe)
+    {
+        NameSlot& s = counters.names[(slot + probe) % NMEAMaxNamesPerThread];
+        const std::uint32_t stored = s.code.load(std::memory_order_relaxed);
+        if (stored == code)
+        {
+            increment(s.count);
+            return;
+        }
+        if (stored == 0)
+        {
+            s.count.store(1, std::memory_order_relaxed);
+            s.code.store(code, std::memory_order_release);
+            return;
+        }
+    }
+
+    increment(counters.otherMessages);
+}
+
+NMEAMessageName nameFromCode(std::uint32_t code)
+{
+    const char chars[] = { static_cast<char>(code & 0xFF), static_cast<char>((code >> 8) & 0xFF),
+                           static_cast<char>((code >> 16) & 0xFF) };
+    return NMEAMessageName(std::string_view(chars, NMEAMessageName::Length));
+}
+
+} // namespace
+
+static_assert(static_cast<std::size_t>(NMEADecodeStatus::DecodeFailed) + 1 == NMEADecodeStatusCount,
+              "NMEADecodeStatusCount is out of date");
+static_assert(NMEAMaxNamesPerThread == 64, "countName() hashes to 6 bits");
+
+const char* toString(NMEALatencyStage stage)
+{
+    switch (stage) {
+    case NMEALatencyStage::Parse:  return "PARSE";
+    case NMEALatencyStage::Decode: return "DECODE";
+    }
+    return "UNKNOWN_LATENCY_STAGE";
+}
+
+std::uint64_t NMEALatencyHistogram::samples() const
+{
+    std::uint64_t total = 0;
+    for (std::uint64_t c : counts)
+        total += c;
+    return total;
+}
+
+std::uint64_t NMEALatencyHistogram::quantileUpperBound(double q) const
+{
+    const std::uint64_t total = samples();
+    if (total == 0)
+        return 0;
+
+    const double clamped = std::min(std::max(q, 0.0), 1.0);
+    const auto rank = std::max<std::uint64_t>(1, static_cast<std::uint64_t>(std::ceil(clamped * static_cast<double>(total))));
+    std::uint64_t seen = 0;
+    for (std::size_t i = 0; i < Buckets; ++i)
+    {
+        seen += counts[i];
+        if (seen >= rank)
+            return std::uint64_t{1} << (i + 1);
+    }
+    return std::uint64_t{1} << Buckets;
+}
+
+std::size_t NMEALatencyHistogram::bucketOf(std::uint64_t nanoseconds)
+{
+    std::size_t bucket = 0;
+    while (nanoseconds > 1 && bucket + 1 < Buckets)
+    {
+        nanoseconds >>= 1;
+        ++bucket;
+    }
+    return bucket;
+}
+
+std::uint64_t NMEADecodeStatsSnapshot::total() const
+{
+    std::uint64_t sum = 0;
+    for (std::uint64_t c : statusCounts)
+        sum += c;
+    return sum;
+}
+
+std::uint64_t NMEADecodeStatsSnapshot::count(NMEAMessageName name) const
+{
+    auto it = std::lower_bound(messageCounts.begin(), messageCounts.end(), name,
+                               [](const auto& entry, NMEAMessageName n) { return entry.first < n; });
+    return it != messageCounts.end() && it->first == name ? it->second : 0;
+}
+
+void recordNMEADecode(NMEADecodeStatus status, NMEAMessageName name)
+{
+    ThreadCounters& counters = localCounters();
+    increment(counters.status[static_cast<std::size_t>(status)]);
+    if (name.isValid())
+        countName(counters, name);
+}
+
+void recordNMEALatency(NMEALatencyStage stage, std::uint64_t nanoseconds)
+{
+    increment(localCounters().latency[static_cast<std::size_t>(stage)][NMEALatencyHistogram::bucketOf(nanoseconds)]);
+}
+
+NMEADecodeStatsSnapshot nmeaDecodeStats()
+{
+    NMEADecodeStatsSnapshot snapshot;
+    std::map<NMEAMessageName, std::uint64_t> names;
+
+    StatsRegistry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    for (const auto& block : r.blocks)
+    {
+        for (std::size_t i = 0; i < NMEADecodeStatusCount; ++i)
+            snapshot.statusCounts[i] += block->status[i].load(std::memory_order_relaxed);
+        snapshot.otherMessages += block->otherMessages.load(std::memory_order_relaxed);
+
+        for (const NameSlot& slot : block->names)
+        {
+            const std::uint32_t code = slot.code.load(std::memory_order_acquire);
+            const std::uint64_t count = code ? slot.count.load(std::memory_order_relaxed) : 0;
+            if (count)
+                names[nameFromCode(code)] += count;
+        }
+
+        for (std::size_t stage = 0; stage < NMEALatencyStageCount; ++stage)
+            for (std::size_t i = 0; i < NMEALatencyHistogram::Buckets; ++i)
+                snapshot.latency[stage].counts[i] += block->latency[stage][i].load(std::memory_order_relaxed);
+    }
+
+    snapshot.messageCounts.assign(names.begin(), names.end());
+    return snapshot;
+}
+
+void resetNMEADecodeStats()
+{
+    StatsRegistry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    for (const auto& block : r.blocks)
+    {
+        for (Counter& c : block->status)
+            c.store(0, std::memory_order_relaxed);
+        block->otherMessages.store(0, std::memory_order_relaxed);
+
+        // Names stay claimed so the owner's table never changes under it; only counts reset
+        for (NameSlot& slot : block->names)
+            slot.count.store(0, std::memory_order_relaxed);
+
+        for (auto& stage : block->latency)
+            for (Counter& c : stage)
+                c.store(0, std::memory_order_relaxed);
+    }
+}
+
+void setNMEALatencyHistogramsEnabled(bool enabled)
+{
+    latencyHistogramsEnabled.store(enabled, std::memory_order_relaxed);
+}
+
+bool nmeaLatencyHistogramsEnabled()
+{
+    return latencyHistogramsEnabled.load(std::memory_order_relaxed);
+}
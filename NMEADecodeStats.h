@@ -0,0 +1,166 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2025 Mark Wilson
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+//  https://www.boost.org/LICENSE_1_0.txt)
+//-----------------------------------------------------------------------------
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "NMEACommon.h"
+#include "NMEAHeader.h"
+
+//
+// Process-wide decode statistics. Every thread counts into its own cache line padded block,
+// written with plain relaxed stores (no lock, no read-modify-write, no I/O), and
+// nmeaDecodeStats() adds the blocks up on demand.
+//
+// Who counts what:
+//  - NMEAExtractionStream counts BadFraming when a sentence it is given does not parse.
+//  - NMEAMessageRegistry::decode counts every other outcome, and the message name of each
+//    sentence that got past the header (Ok, UnknownType, DecodeFailed).
+//  - NMEAMessageRegistry::decodeDeferred leaves Ok and DecodeFailed to AnyNMEAMessage,
+//    which counts them when a deferred payload is first extracted.
+//
+
+/// Number of NMEADecodeStatus values.
+constexpr std::size_t NMEADecodeStatusCount = 6;
+
+/**
+ * @brief The NMEALatencyStage enum names the steps latency histograms are kept for.
+ */
+enum class NMEALatencyStage : std::uint8_t
+{
+    Parse = 0, ///< NMEAExtractionStream framing and checksum scan
+    Decode     ///< Payload extraction by the registered message type
+};
+
+constexpr std::size_t NMEALatencyStageCount = 2;
+
+const char* toString(NMEALatencyStage stage);
+
+/**
+ * @brief The NMEALatencyHistogram struct counts samples in power of two nanosecond buckets:
+ * bucket 0 holds [0, 2) ns, bucket i holds [2^i, 2^(i+1)) ns and the last one everything
+ * from 2^(Buckets-1) ns up.
+ */
+struct NMEALatencyHistogram
+{
+    static constexpr std::size_t Buckets = 32;
+
+    std::array<std::uint64_t, Buckets> counts {};
+
+    std::uint64_t samples() const;
+
+    /// @return The upper bound in ns of the bucket holding quantile q (0..1), or 0 if empty.
+    std::uint64_t quantileUpperBound(double q) const;
+
+    static std::size_t bucketOf(std::uint64_t nanoseconds);
+};
+
+/**
+ * @brief The NMEADecodeStatsSnapshot struct is the sum of every thread's counters at the
+ * time nmeaDecodeStats() ran.
+ */
+struct NMEADecodeStatsSnapshot
+{
+    std::array<std::uint64_t, NMEADecodeStatusCount> statusCounts {};
+
+    /// Sentences per message name, sorted by name.
+    std::vector<std::pair<NMEAMessageName, std::uint64_t>> messageCounts;
+
+    /// Sentences whose name did not fit a thread's name table (see NMEAMaxNamesPerThread).
+    std::uint64_t otherMessages {0};
+
+    std::array<NMEALatencyHistogram, NMEALatencyStageCount> latency {};
+
+    std::uint64_t count(NMEADecodeStatus status) const { return statusCounts[static_cast<std::size_t>(status)]; }
+
+    std::uint64_t accepted() const { return count(NMEADecodeStatus::Ok); }
+
+    std::uint64_t rejected() const { return total() - accepted(); }
+
+    std::uint64_t total() const;
+
+    /// @return How many sentences named name were counted, 0 if none.
+    std::uint64_t count(NMEAMessageName name) const;
+
+    const NMEALatencyHistogram& histogram(NMEALatencyStage stage) const
+    {
+        return latency[static_cast<std::size_t>(stage)];
+    }
+};
+
+/**
+ * @brief NMEAMaxNamesPerThread is how many distinct message names each thread keeps a counter
+ * for; further names are only counted in NMEADecodeStatsSnapshot::otherMessages.
+ */
+constexpr std::size_t NMEAMaxNamesPerThread = 64;
+
+/**
+ * @brief recordNMEADecode counts one outcome, and name too if it is valid.
+ */
+void recordNMEADecode(NMEADecodeStatus status, NMEAMessageName name = NMEAMessageName());
+
+void recordNMEALatency(NMEALatencyStage stage, std::uint64_t nanoseconds);
+
+/**
+ * @brief nmeaDecodeStats adds up every thread's counters, those of threads that have exited
+ * included. It takes a lock, so call it from a reporting thread, not per sentence. Counters
+ * are read while other threads may be writing them: each one is exact, but they are not
+ * taken at a single instant.
+ */
+NMEADecodeStatsSnapshot nmeaDecodeStats();
+
+/**
+ * @brief resetNMEADecodeStats zeroes every counter. Only exact while no thread is decoding;
+ * an increment racing with it may survive.
+ */
+void resetNMEADecodeStats();
+
+/**
+ * @brief setNMEALatencyHistogramsEnabled turns latency recording on or off for all threads.
+ * It is off by default; while off no clock is read.
+ */
+void setNMEALatencyHistogramsEnabled(bool enabled);
+
+bool nmeaLatencyHistogramsEnabled();
+
+/**
+ * @brief The NMEALatencyScope class records the time from its construction to its
+ * destruction into stage's histogram, when histograms are enabled.
+ */
+class NMEALatencyScope
+{
+public:
+    explicit NMEALatencyScope(NMEALatencyStage stage) :
+        mStage(stage), mEnabled(nmeaLatencyHistogramsEnabled())
+    {
+        if (mEnabled)
+            mStart = Clock::now();
+    }
+
+    ~NMEALatencyScope()
+    {
+        if (mEnabled)
+            recordNMEALatency(mStage, static_cast<std::uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - mStart).count()));
+    }
+
+    NMEALatencyScope(const NMEALatencyScope&) = delete;
+    NMEALatencyScope& operator=(const NMEALatencyScope&) = delete;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    NMEALatencyStage mStage;
+    bool mEnabled;
+    Clock::time_point mStart;
+};
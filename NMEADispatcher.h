@@ -0,0 +1,153 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2025 Mark Wilson
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+//  https://www.boost.org/LICENSE_1_0.txt)
+//-----------------------------------------------------------------------------
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "AnyNMEAMessage.h"
+#include "NMEAExceptions.h"
+
+/**
+ * @brief The NMEADispatcher class routes messages to handlers registered per payload type,
+ * and optionally per talker, replacing chains of isType<T>() tests.
+ *
+ * Handlers are kept in a table indexed by AnyNMEAMessage::TypeIndex, so dispatch() finds a
+ * message's subscribers with one array lookup however many types are registered, and calls
+ * each one with the payload as a const T& without checking the type again.
+ *
+ * A handler takes (const T&) or (const T&, const AnyNMEAMessage&), the latter for access to
+ * the header. Subscribing is not safe while another thread dispatches; dispatching from
+ * several threads at once is, as long as the handlers are.
+ *
+ * @code
+ * NMEADispatcher dispatcher;
+ * dispatcher.subscribe<GGAMessage>([&](const GGAMessage& gga) { fusion.update(gga); });
+ * dispatcher.subscribe<RMCMessage>("GN", [&](const RMCMessage& rmc) { display.show(rmc); });
+ * for (const auto& message : messages)
+ *     dispatcher.dispatch(message);
+ * @endcode
+ */
+class NMEADispatcher
+{
+public:
+    /// @brief subscribe calls handler for every T message, whatever its talker.
+    template <class T, class Handler>
+    void subscribe(Handler&& handler)
+    {
+        add<T>(0, std::forward<Handler>(handler));
+    }
+
+    /// @brief subscribe calls handler for T messages from talker only ("GP", "GN"...).
+    template <class T, class Handler>
+    void subscribe(std::string_view talker, Handler&& handler)
+    {
+        if (talker.size() != 2)
+            NMEA_THROW(std::invalid_argument("talker must be 2 chars"));
+        add<T>(talkerCode(talker), std::forward<Handler>(handler));
+    }
+
+    /// @brief setUnhandled calls handler for messages no subscriber took, empty ones included.
+    void setUnhandled(std::function<void(const AnyNMEAMessage&)> handler)
+    {
+        mUnhandled = std::move(handler);
+    }
+
+    /// @return The number of handlers message was passed to; 0 if it went to the unhandled
+    /// handler (or nowhere).
+    std::size_t dispatch(const AnyNMEAMessage& message) const
+    {
+        std::size_t called = 0;
+
+        const AnyNMEAMessage::TypeIndex index = message.getTypeIndex();
+        if (index < mTable.size() && !mTable[index].empty())
+        {
+            const std::uint16_t talker = talkerCode(message.getTalker());
+
+            for (const auto& subscriber : mTable[index])
+            {
+                if (subscriber.talker == 0 || subscriber.talker == talker)
+                {
+                    subscriber.call(subscriber.handler.get(), message);
+                    ++called;
+                }
+            }
+        }
+
+        if (called == 0 && mUnhandled)
+            mUnhandled(message);
+        return called;
+    }
+
+    /// @return How many handlers are subscribed to T.
+    template <class T>
+    std::size_t subscribers() const
+    {
+        const AnyNMEAMessage::TypeIndex index = AnyNMEAMessage::typeIndex<T>();
+        return index < mTable.size() ? mTable[index].size() : 0;
+    }
+
+    void clear()
+    {
+        mTable.clear();
+        mUnhandled = nullptr;
+    }
+
+private:
+    // Knows the payload type, so it reads the payload without checking it
+    using CallFunction = void (*)(void* handler, const AnyNMEAMessage& message);
+
+    struct Subscriber
+    {
+        std::uint16_t talker; ///< 0 for any talker
+        CallFunction call;
+        std::shared_ptr<void> handler;
+    };
+
+    static std::uint16_t talkerCode(std::string_view talker) noexcept
+    {
+        if (talker.size() != 2)
+            return 0;
+        return static_cast<std::uint16_t>(static_cast<unsigned char>(talker[0])
+                                          | (static_cast<unsigned char>(talker[1]) << 8));
+    }
+
+    template <class T, class Handler>
+    void add(std::uint16_t talker, Handler&& handler)
+    {
+        using Payload = std::decay_t<T>;
+        static_assert(std::is_invocable<Handler&, const Payload&>::value
+                      || std::is_invocable<Handler&, const Payload&, const AnyNMEAMessage&>::value,
+                      "handler must take (const T&) or (const T&, const AnyNMEAMessage&)");
+
+        const AnyNMEAMessage::TypeIndex index = AnyNMEAMessage::typeIndex<Payload>();
+        if (index >= mTable.size())
+            mTable.resize(index + 1);
+
+        using Stored = std::decay_t<Handler>;
+        auto call = [](void* handler, const AnyNMEAMessage& message) {
+            Stored& h = *static_cast<Stored*>(handler);
+            const Payload& value = *message.payload<Payload>();
+            if constexpr (std::is_invocable<Stored&, const Payload&, const AnyNMEAMessage&>::value)
+                h(value, message);
+            else
+                h(value);
+        };
+        mTable[index].push_back({talker, call, std::make_shared<Stored>(std::forward<Handler>(handler))});
+    }
+
+    std::vector<std::vector<Subscriber>> mTable; ///< indexed by AnyNMEAMessage::TypeIndex
+    std::function<void(const AnyNMEAMessage&)> mUnhandled;
+};
@@ -0,0 +1,40 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2025 Mark Wilson
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+//  https://www.boost.org/LICENSE_1_0.txt)
+//-----------------------------------------------------------------------------
+#pragma once
+
+#include <cstdlib>
+
+//
+// The library builds with and without exceptions (-fno-exceptions, NMEA_NO_EXCEPTIONS in
+// CMake). Without them:
+//  - NMEA_THROW calls std::abort(). Only misuse throws (get<T>() of the wrong type,
+//    serializing an empty message, an invalid talker passed to a constructor, a capture
+//    file that cannot be mapped); the try* functions and the checked decode report the same
+//    conditions without throwing and are what to use in such builds. The exception
+//    expression still appears, unevaluated, so variables only it uses are not unused.
+//  - NMEA_TRY runs its block and NMEA_CATCH_ALL's block is compiled but never runs, so
+//    cleanup written for the exceptional path costs nothing.
+//
+
+#if defined(__cpp_exceptions) || defined(__EXCEPTIONS) || defined(_CPPUNWIND)
+#define NMEA_HAS_EXCEPTIONS 1
+#else
+#define NMEA_HAS_EXCEPTIONS 0
+#endif
+
+#if NMEA_HAS_EXCEPTIONS
+#define NMEA_TRY try
+#define NMEA_CATCH_ALL catch (...)
+#define NMEA_RETHROW throw
+#define NMEA_THROW(exception) throw exception
+#else
+#define NMEA_TRY if (true)
+#define NMEA_CATCH_ALL else
+#define NMEA_RETHROW static_cast<void>(0)
+#define NMEA_THROW(exception) (static_cast<void>(sizeof((exception))), std::abort())
+#endif
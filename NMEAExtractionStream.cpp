@@ -5,7 +5,7 @@
 // (See accompanying file LICENSE_1_0.txt or copy at
 //  https://www.boost.org/LICENSE_1_0.txt)
 //-----------------------------------------------------------------------------
-#include <iostream>
+#include <algorithm>
 #include <charconv>
 #include <stdexcept>
 #include <cmath>
@@ -14,240 +14,325 @@
 #include <string>
 
 #include "ImmutableBuffer.h"
+#include "NMEADecodeStats.h"
 #include "NMEAExtractionStream.h"
+#include "NMEAFieldParsers.h"
+#include "NMEAScanner.h"
 #include "Register32Bits.h"
 
 using namespace std;
 
+namespace {
 
+bool isHexDigit(char c)
+{
+    return (c >= '0' && c <= '9') || (c >= 'A' && c <= 'F') || (c >= 'a' && c <= 'f');
+}
 
-// Forward declarations
-FieldStrings parseMessage(std::string_view message);
-std::string_view skip_leading_whitespace(std::string_view strv);
+} // namespace
 
+NMEAExtractionStream::NMEAExtractionStream(const ImmutableBuffer &nmeaMessage)
+{
+    rebind(nmeaMessage);
+}
 
-NMEAExtractionStream::NMEAExtractionStream(const ImmutableBuffer &nmeaMessage) :
-    mNMEAMessage(nmeaMessage)
+NMEAExtractionStream::NMEAExtractionStream(NMEAFieldScan scan) :
+    mFieldScan(scan)
 {
-    mFields = parseMessage(nmeaMessage.data());
+}
 
-    //for (auto field : mFields)
-        //cout << "** field = " << field << endl;
+void NMEAExtractionStream::setFieldScan(NMEAFieldScan scan)
+{
+    mFieldScan = scan;
+}
 
-    if ( mFields.size() > 0 )
-    {
-        mTalker = mFields[0].substr(0, 2);
-        mMessage = mFields[0].substr(2, 3);
-    }
+NMEAFieldScan NMEAExtractionStream::fieldScan() const
+{
+    return mFieldScan;
+}
+
+void NMEAExtractionStream::rebind(const ImmutableBuffer &nmeaMessage)
+{
+    mSentence = std::string_view(nmeaMessage.data(), nmeaMessage.size());
+    mFieldIdx = 1;
+
+    if ( mFieldScan == NMEAFieldScan::Lazy )
+        frame();
     else
-    {
-        mTalker = "XX";
-        mMessage = "YYY";
-    }
+        parse();
+
+    // A lazy stream splits off just the header field here
+    mHeader = NMEAHeader::fromField(field(0));
+    clearStatus();
+}
+
+std::string_view NMEAExtractionStream::getTalker() const
+{
+    return mHeader.talker();
 }
 
-std::string NMEAExtractionStream::getTalker() const
+std::string_view NMEAExtractionStream::getMessage() const
 {
-    return mTalker;
+    return mHeader.messageName();
 }
 
-std::string NMEAExtractionStream::getMessage() const
+NMEAHeader NMEAExtractionStream::getHeader() const
 {
-    return mMessage;
+    return mHeader;
+}
+
+std::string_view NMEAExtractionStream::getSentence() const
+{
+    return mSentence;
+}
+
+bool NMEAExtractionStream::isFramed() const
+{
+    return mFramedFlag;
 }
 
 bool NMEAExtractionStream::isChecksumValid() const
 {
-    return false;
+    if ( mScanPending )
+        completeScan();
+
+    return mChecksumValidFlag;
 }
 
-bool NMEAExtractionStream::numberOfFields() const
+std::size_t NMEAExtractionStream::numberOfFields() const
 {
-    return mFields.size();
+    if ( mScanPending )
+        completeScan();
+
+    return mFieldCount;
 }
 
 void NMEAExtractionStream::reset()
 {
     mFieldIdx = 1;
+    clearStatus();
 }
 
-const NMEAExtractionStream &NMEAExtractionStream::operator>>(int &value)
+void NMEAExtractionStream::clearStatus()
 {
-    auto nows = skip_leading_whitespace(mFields[mFieldIdx]);
-    const char *start = nows.data();
-    std::size_t sz = nows.size();
+    mFieldStatus.fill(NMEAFieldStatus::Ok);
+    mLastStatus = NMEAFieldStatus::Ok;
+    mGood = mFieldCount > 0;
+}
 
-    int i;
+std::string_view NMEAExtractionStream::field(std::size_t idx) const
+{
+    if ( idx >= mFieldCount && mScanPending )
+        scanTo(idx);
 
-    char *endptr;
-    i = strtol(start, &endptr, 10);
-    value = i;
+    if ( idx >= mFieldCount )
+        return std::string_view();
 
-#if 0
-    auto result = std::from_chars(start, start + sz, i);
-    if (result.ec == std::errc::invalid_argument)
-    {
-        value = std::numeric_limits<int>::min();
-    }
-    else
-    {
-        value = i;
-    }
-#endif
+    std::size_t start = mFieldStart[idx];
+    return mSentence.substr(start, mFieldStart[idx + 1] - 1 - start);
+}
 
+std::string_view NMEAExtractionStream::nextField()
+{
+    std::string_view f = field(mFieldIdx);
     mFieldIdx++;
-
-    return *this;
+    return f;
 }
-
-const NMEAExtractionStream &NMEAExtractionStream::operator>>(unsigned int &value)
+void NMEAExtractionStream::setStatus(NMEAFieldStatus status)
 {
-    auto nows = skip_leading_whitespace(mFields[mFieldIdx]);
-    const char *start = nows.data();
-    //std::size_t sz = nows.size();
+    std::size_t idx = mFieldIdx - 1u;
 
-    int i;
+    if ( idx >= mFieldCount )
+        status = NMEAFieldStatus::Missing;
 
-    char *endptr;
-    i = strtol(start, &endptr, 10);
-    value = i;
+    if ( idx < mFieldStatus.size() )
+        mFieldStatus[idx] = status;
 
-    mFieldIdx++;
+    mLastStatus = status;
 
-    return *this;
+    if ( status != NMEAFieldStatus::Ok && status != NMEAFieldStatus::Empty )
+        mGood = false;
 }
 
-const NMEAExtractionStream &NMEAExtractionStream::operator>>(double &value)
+NMEAFieldStatus NMEAExtractionStream::fieldStatus(std::size_t idx) const
 {
-    auto nows = skip_leading_whitespace(mFields[mFieldIdx]);
-    const char *start = nows.data();
-    std::size_t sz = nows.size();
-
-    if (sz == 0) {
-        value = std::nan("");
-        mFieldIdx++;
-        return *this;
-    }
+    if ( idx >= mFieldCount && mScanPending )
+        scanTo(idx);
 
-    double d;
-    char *end;
+    if ( idx >= mFieldCount )
+        return NMEAFieldStatus::Missing;
 
-    d = std::strtod(start, &end);
-    value = d;
+    return mFieldStatus[idx];
+}
 
-#if 0
-    auto result = std::from_chars(start, start + sz, d);
-    if (result.ec == std::errc::invalid_argument) {
-        value = std::nan("");
-    }
-    else
-        value = d;
+NMEAFieldStatus NMEAExtractionStream::lastStatus() const
+{
+    return mLastStatus;
+}
 
-#endif
+bool NMEAExtractionStream::good() const
+{
+    return mGood;
+}
 
-    mFieldIdx++;
+NMEAExtractionStream &NMEAExtractionStream::operator>>(int &value)
+{
+    int i = 0;
+    NMEAFieldStatus status = parseNMEAInt(nextField(), i);
+    value = status == NMEAFieldStatus::Ok ? i : 0;
+    setStatus(status);
 
     return *this;
 }
 
-const NMEAExtractionStream &NMEAExtractionStream::operator>>(Register32Bits &value)
+NMEAExtractionStream &NMEAExtractionStream::operator>>(unsigned int &value)
 {
-    auto nows = skip_leading_whitespace(mFields[mFieldIdx]);
-    const char *start = nows.data();
-    std::size_t sz = nows.size();
+    unsigned int u = 0;
+    NMEAFieldStatus status = parseNMEAUnsigned(nextField(), u);
+    value = status == NMEAFieldStatus::Ok ? u : 0;
+    setStatus(status);
+
+    return *this;
+}
 
-    int i;
-    //auto result = std::from_chars(start, start + sz, i, 16);
-    char *endptr;
-    i = strtol(start, &endptr, 16);
+NMEAExtractionStream &NMEAExtractionStream::operator>>(double &value)
+{
+    double d = 0.0;
+    NMEAFieldStatus status = parseNMEADouble(nextField(), d);
+    value = status == NMEAFieldStatus::Ok ? d : std::nan("");
+    setStatus(status);
 
-    //if (result.ec == std::errc::invalid_argument)
-    //{
-        // value will be empty, do 'if (value)' to tell if it is good.
-        //value = Register32Bits();
-    //}
-    //else
-    //{
-    //}
+    return *this;
+}
 
-    value = Register32Bits(i);
+NMEAExtractionStream &NMEAExtractionStream::operator>>(Register32Bits &value)
+{
+    std::uint32_t bits = 0;
+    NMEAFieldStatus status = parseNMEAHex(nextField(), bits);
 
-    mFieldIdx++;
+    // value will be empty unless parsed, do 'if (value.isEmpty())' to tell if it is good.
+    value = status == NMEAFieldStatus::Ok ? Register32Bits(bits) : Register32Bits();
+    setStatus(status);
 
     return *this;
 }
 
-const NMEAExtractionStream &NMEAExtractionStream::operator>>(std::string &value)
+NMEAExtractionStream &NMEAExtractionStream::operator>>(std::string &value)
 {
-    std::string_view f = mFields[mFieldIdx];
+    std::string_view f = nextField();
 
-    std::copy(f.begin(), f.end(), std::back_inserter(value));
-
-    mFieldIdx++;
+    value.assign(f.begin(), f.end());
+    setStatus(f.empty() ? NMEAFieldStatus::Empty : NMEAFieldStatus::Ok);
 
     return *this;
 }
 
-void NMEAExtractionStream::_extractPayload(const char *nmeaMessage)
+NMEAExtractionStream &NMEAExtractionStream::operator>>(std::string_view &value)
 {
+    value = nextField();
+    setStatus(value.empty() ? NMEAFieldStatus::Empty : NMEAFieldStatus::Ok);
 
+    return *this;
 }
 
-// Function to split string based on a delimiter into a vector of string_views
-FieldStrings splitString(std::string_view str, char delim)
+NMEAExtractionStream &NMEAExtractionStream::operator>>(const Skip &skip)
 {
-    std::vector<std::string_view> result;
-    size_t start = 0;
-    size_t end = str.find(delim);
+    mFieldIdx = static_cast<uint16_t>(std::min<std::size_t>(mFieldIdx + skip.count, MaxFields));
 
-    while (end != std::string_view::npos) {
-        result.push_back(str.substr(start, end - start));
-        start = end + 1;
-        end = str.find(delim, start);
-    }
+    return *this;
+}
 
-    result.push_back(str.substr(start));
+NMEAExtractionStream &NMEAExtractionStream::operator>>(const Seek &seek)
+{
+    mFieldIdx = static_cast<uint16_t>(std::min<std::size_t>(seek.idx, MaxFields));
 
-    return result;
+    return *this;
 }
 
-// Function to parse the message and return a vector of fields
-FieldStrings parseMessage(std::string_view message)
+// Splits the sentence into fields by recording where each one starts in mFieldStart
+void NMEAExtractionStream::parse() const
 {
-    //cout << "[parseMessage] message = '" << message << "'" << endl;
-    // Check for the starting '$' and the '*' before the checksum
+    mScanPending = false;
 
-    if (message.front() != '$' || message.find('*') == std::string_view::npos) {
-        //throw std::invalid_argument("Invalid message format");
-        std::cerr << "MISSED A MESSAGE DUE TO INVALID FORMAT" << std::endl;
-        return FieldStrings {};
-        
+    NMEAScanResult scan;
+    {
+        NMEALatencyScope latency(NMEALatencyStage::Parse);
+        scanNMEASentence(mSentence, mFieldStart.data(), MaxFields, scan);
     }
 
-    // Find position of '*' which starts the checksum part
-    size_t checksumStart = message.rfind('*');
-    if (checksumStart == std::string_view::npos || checksumStart + 3 != message.size()) {
-        std::cerr << "MISSED A MESSAGE DUE TO INVALID CHECKSUM FORMAT" << std::endl;
-        //throw std::invalid_argument("Invalid checksum format");
-        return FieldStrings {};
-    }
+    mFieldCount = scan.fieldCount;
+    mChecksum = scan.checksum;
+    mFramedFlag = scan.framed;
+    mChecksumValidFlag = scan.checksumValid;
 
-    // Extract the checksum part (excluding '*')
-    std::string_view checksum = message.substr(checksumStart + 1, 2);
+    // Counted, not logged: a noisy line must not serialize every decoder on std::cerr
+    if (!scan.framed)
+        recordNMEADecode(NMEADecodeStatus::BadFraming);
+}
 
-    // Extract the main content between '$' and '*'
-    std::string_view content = message.substr(1, checksumStart - 1);
+void NMEAExtractionStream::frame()
+{
+    mFieldCount = 0;
+    mChecksum = 0;
+    mFramedFlag = false;
+    mChecksumValidFlag = false;
+    mScanPending = false;
+
+    const char* s = mSentence.data();
+    const std::size_t n = mSentence.size();
+
+    // Trailer is exactly "*hh" or "*hh\r\n", as scanNMEASentence requires
+    std::size_t star = n >= 5 && s[n - 2] == '\r' && s[n - 1] == '\n' ? n - 5 : n - 3;
+    if ( n < 4 || n > UINT16_MAX || s[0] != '$' || star == 0 || s[star] != '*'
+         || !isHexDigit(s[star + 1]) || !isHexDigit(s[star + 2]) )
+    {
+        recordNMEADecode(NMEADecodeStatus::BadFraming);
+        return;
+    }
 
-    // Split the content into fields based on ','
-    return splitString(content, ',');
+    mFieldStart[0] = 1;
+    mStarPos = static_cast<std::uint16_t>(star);
+    mScanPos = 1;
+    mFramedFlag = true;
+    mScanPending = true;
 }
 
+void NMEAExtractionStream::scanTo(std::size_t idx) const
+{
+    const char* s = mSentence.data();
+    std::size_t pos = mScanPos;
 
-std::string_view skip_leading_whitespace(std::string_view strv) {
-    size_t pos = 0;
-    while (pos < strv.length() && std::isspace(strv[pos])) {
-        pos++;
+    while ( mFieldCount <= idx && pos <= mStarPos )
+    {
+        // Fields are a few bytes long: a plain loop beats a memchr call per field
+        std::size_t end = pos;
+        while ( end < mStarPos && s[end] != ',' && s[end] != '*' )
+            ++end;
+
+        if ( end == mStarPos )
+        {
+            // The trailer's '*' closes the last field
+            mFieldStart[++mFieldCount] = static_cast<std::uint16_t>(mStarPos + 1);
+            pos = mStarPos + 1u;
+            break;
+        }
+
+        // A '*' before the trailer's makes the sentence unframed, and one field more than
+        // the table holds rejects it: leave both to parse()
+        if ( s[end] == '*' || mFieldCount + 2u > MaxFields )
+        {
+            completeScan();
+            return;
+        }
+
+        pos = end + 1;
+        mFieldStart[++mFieldCount] = static_cast<std::uint16_t>(pos);
     }
-    strv.remove_prefix(pos);
-    return strv;
+
+    mScanPos = static_cast<std::uint16_t>(pos);
+}
+
+void NMEAExtractionStream::completeScan() const
+{
+    parse();
 }
@@ -7,69 +7,257 @@
 //-----------------------------------------------------------------------------
 #pragma once
 
-#include <vector>
+#include <array>
+#include <cstdint>
 #include <string>
+#include <string_view>
+
+#include "NMEAFieldParsers.h"
+#include "NMEAHeader.h"
 
 class ImmutableBuffer;
 class Register32Bits;
 
-using FieldStrings = std::vector<std::string_view>;
+/**
+ * @brief The NMEAFieldScan enum says when an NMEAExtractionStream finds its field boundaries.
+ */
+enum class NMEAFieldScan : std::uint8_t
+{
+    Eager, ///< The whole sentence at rebind(), checksum included
+    Lazy   ///< Only as far as the highest field read so far; see setFieldScan()
+};
 
 /**
  * @brief The NMEAExtractionStream class is used to extract field data from an NMEAMessage.
+ *
+ * Field boundaries are kept in a fixed size table inside the stream, so parsing a sentence
+ * never allocates. One stream can be reused for many sentences with rebind().
  */
 class NMEAExtractionStream
 {
 public:
-    NMEAExtractionStream() = delete;
+    /**
+     * @brief MaxFields is the largest number of fields (header field included) a sentence
+     * may have. An 82 byte sentence has at most 72; anything beyond MaxFields is rejected.
+     */
+    static constexpr std::size_t MaxFields = 80;
+
+    /**
+     * @brief Constructs a stream with no sentence; every field reads as empty until rebind().
+     */
+    NMEAExtractionStream() = default;
 
     explicit NMEAExtractionStream(const ImmutableBuffer &nmeaMessage);
 
+    explicit NMEAExtractionStream(NMEAFieldScan scan);
+
     /// @todo delete copy and move
 
-    std::string getTalker() const;
+    /**
+     * @brief The Skip struct is an NMEAExtractionStream manipulator: stream >> Skip{2} passes
+     * over the next 2 fields without parsing them.
+     */
+    struct Skip
+    {
+        std::size_t count = 1;
+    };
+
+    /**
+     * @brief The Seek struct is an NMEAExtractionStream manipulator: stream >> Seek{7} makes
+     * field 7 the next one extracted, backwards or forwards. Field 1 is the first after the
+     * header.
+     */
+    struct Seek
+    {
+        std::size_t idx = 1;
+    };
 
-    std::string getMessage() const;
+    /**
+     * @brief setFieldScan picks the scan mode used from the next rebind() on.
+     *
+     * In Lazy mode rebind() only checks that the sentence starts with '$' and ends in a
+     * "*hh" trailer; fields are then split off on demand, only as far as the highest one
+     * read, so a consumer that needs field 2 of a 20 field sentence never looks at the
+     * other 18. numberOfFields() and isChecksumValid() need the whole sentence and scan the
+     * rest of it on first call. Until then isFramed() reflects the trailer check only: a
+     * stray '*' or too many fields are found, and the sentence treated as unframed, once
+     * the scan reaches them.
+     */
+    void setFieldScan(NMEAFieldScan scan);
+
+    NMEAFieldScan fieldScan() const;
 
-    bool numberOfFields() const;
+    /**
+     * @brief rebind points the stream at a new sentence and rewinds it, reusing the field table.
+     * The stream keeps views into nmeaMessage, which must outlive the extraction.
+     */
+    void rebind(const ImmutableBuffer &nmeaMessage);
 
+    std::string_view getTalker() const;
+
+    std::string_view getMessage() const;
+
+    /**
+     * @brief getHeader returns the talker and message name packed together; invalid if
+     * the sentence could not be parsed.
+     */
+    NMEAHeader getHeader() const;
+
+    /**
+     * @brief getSentence returns the sentence the stream is bound to, as given to rebind().
+     */
+    std::string_view getSentence() const;
+
+    std::size_t numberOfFields() const;
+
+    /**
+     * @brief isFramed
+     * @return true if the sentence has the "$...*hh" shape and fits the field table,
+     * whether or not the checksum matches.
+     */
+    bool isFramed() const;
+
+    /**
+     * @brief isChecksumValid
+     * @return true if the sentence is framed correctly and its "*hh" matches the payload.
+     */
     bool isChecksumValid() const;
 
     void reset();
 
-    const NMEAExtractionStream& operator>>(int& value);
+    /**
+     * @brief fieldStatus
+     * @return How the last extraction of field idx went (Ok if it has not been extracted
+     * yet), or Missing if the sentence has no such field.
+     */
+    NMEAFieldStatus fieldStatus(std::size_t idx) const;
+
+    /**
+     * @brief lastStatus
+     * @return The status of the most recent operator>>.
+     */
+    NMEAFieldStatus lastStatus() const;
+
+    /**
+     * @brief good
+     * @return false if the sentence did not parse, or any extraction since rebind()/reset()
+     * was Invalid, OutOfRange or Missing. Empty fields are legal NMEA and leave it true;
+     * check fieldStatus() for those.
+     */
+    bool good() const;
+
+    //
+    // Numeric fields are parsed locale-free and within the field's bounds. On anything but
+    // NMEAFieldStatus::Ok integers become 0, doubles NaN and registers empty.
+    //
 
-    const NMEAExtractionStream& operator>>(unsigned int& value);
+    NMEAExtractionStream& operator>>(int& value);
 
-    const NMEAExtractionStream& operator>>(double& value);
+    NMEAExtractionStream& operator>>(unsigned int& value);
 
-    const NMEAExtractionStream& operator>>(Register32Bits& value);
+    NMEAExtractionStream& operator>>(double& value);
 
-    const NMEAExtractionStream& operator>>(std::string& value);
+    NMEAExtractionStream& operator>>(Register32Bits& value);
+
+    NMEAExtractionStream& operator>>(std::string& value);
+
+    /**
+     * @brief Extracts the next field as a view into the sentence, without copying it.
+     */
+    NMEAExtractionStream& operator>>(std::string_view& value);
+
+    NMEAExtractionStream& operator>>(const Skip& skip);
+
+    NMEAExtractionStream& operator>>(const Seek& seek);
+
+    /**
+     * @brief field returns field idx (0 is the header field) as a view into the sentence,
+     * empty if there is no such field. Does not move the extraction position.
+     */
+    std::string_view field(std::size_t idx) const;
 
 private:
-    const ImmutableBuffer& mNMEAMessage;
-    bool mChecksumValidFlag {false};
+    std::string_view mSentence;
+
+    NMEAFieldScan mFieldScan {NMEAFieldScan::Eager};
+
+    //
+    // The scan state is mutable because a lazy stream fills it in from const queries.
+    //
+
+    mutable bool mFramedFlag {false};
+    mutable bool mChecksumValidFlag {false};
+
+    /**
+     * @brief mFieldStart offset of each field in mSentence. Field i spans
+     * [mFieldStart[i], mFieldStart[i+1] - 1), the extra entry closing the last field.
+     * While a lazy scan is pending, mFieldStart[mFieldCount] is the start of the first
+     * field whose end has not been found yet.
+     */
+    mutable std::array<std::uint16_t, MaxFields + 1> mFieldStart {};
 
-    FieldStrings mFields;
+    mutable std::uint16_t mFieldCount {0};
 
-    unsigned int mChecksum {0};
+    mutable unsigned int mChecksum {0};
 
     /**
-     * @brief mTalker NMEA talker, which is 2 bytes. SSO will kick in, so std::string is okay here.
+     * @brief mScanPending true in Lazy mode until the whole sentence has been scanned.
      */
-    std::string mTalker;
+    mutable bool mScanPending {false};
 
     /**
-     * @brief mMessage NMEA message, which is 3 bytes. SSO will kick in, so std::string is okay here.
+     * @brief mScanPos where a pending lazy scan resumes; past mStarPos once every field
+     * boundary is known.
      */
-    std::string mMessage;
+    mutable std::uint16_t mScanPos {0};
+
+    std::uint16_t mStarPos {0};
+
+    std::array<NMEAFieldStatus, MaxFields> mFieldStatus {};
+
+    NMEAFieldStatus mLastStatus {NMEAFieldStatus::Ok};
+
+    bool mGood {false};
+
+    /**
+     * @brief mHeader NMEA talker (2 bytes) and message (3 bytes), packed.
+     */
+    NMEAHeader mHeader;
 
     uint16_t mFieldIdx{1};
 
     /**
-     * @brief _extractPayload returns a view that includes only the actual NMEA payload fields.
-     * @param nmeaMessage A complete NMEA message: $<talker><message>,<f1>,<f2>,<f3>,...,<fn>,*<checksum>
+     * @brief nextField returns the field at mFieldIdx (empty past the end) and advances.
+     */
+    std::string_view nextField();
+
+    /**
+     * @brief setStatus records the outcome of extracting the field nextField() just returned.
+     */
+    void setStatus(NMEAFieldStatus status);
+
+    void clearStatus();
+
+    /**
+     * @brief parse fills the field table from mSentence in a single scanNMEASentence pass,
+     * which also validates the checksum; leaves the table empty if malformed.
+     */
+    void parse() const;
+
+    /**
+     * @brief frame is parse() for Lazy mode: it checks the "$...*hh" shape from the ends of
+     * the sentence and leaves the fields to scanTo().
+     */
+    void frame();
+
+    /**
+     * @brief scanTo extends a pending lazy field table until field idx is closed or the '*'
+     * is reached.
+     */
+    void scanTo(std::size_t idx) const;
+
+    /**
+     * @brief completeScan finishes a pending lazy scan with a full parse().
      */
-    void _extractPayload(const char* nmeaMessage);
+    void completeScan() const;
 };
@@ -0,0 +1,205 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2025 Mark Wilson
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+//  https://www.boost.org/LICENSE_1_0.txt)
+//-----------------------------------------------------------------------------
+#include <charconv>
+#include <climits>
+#include <limits>
+
+#include "NMEAFieldParsers.h"
+
+namespace {
+
+std::string_view skipLeadingSpaces(std::string_view field)
+{
+    std::size_t pos = 0;
+    while (pos < field.size() && field[pos] == ' ')
+        pos++;
+    return field.substr(pos);
+}
+
+inline bool isDigit(char c)
+{
+    return static_cast<unsigned char>(c - '0') < 10;
+}
+
+// Accumulates [+-]digits into a sign and magnitude. Magnitudes past 19 digits saturate,
+// which every caller treats as out of range.
+NMEAFieldStatus parseInteger(std::string_view field, bool allowMinus, bool& negative, std::uint64_t& magnitude)
+{
+    negative = false;
+    if (field[0] == '-' || field[0] == '+')
+    {
+        negative = field[0] == '-';
+        if (negative && !allowMinus)
+            return NMEAFieldStatus::Invalid;
+        field.remove_prefix(1);
+        if (field.empty())
+            return NMEAFieldStatus::Invalid;
+    }
+
+    constexpr std::uint64_t Saturated = 10000000000000000000ull;
+    std::uint64_t v = 0;
+    for (char c : field)
+    {
+        if (!isDigit(c))
+            return NMEAFieldStatus::Invalid;
+        v = v < Saturated / 10 ? v * 10 + static_cast<unsigned>(c - '0') : Saturated;
+    }
+
+    magnitude = v;
+    return NMEAFieldStatus::Ok;
+}
+
+constexpr double PowersOf10[] = {
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+} // namespace
+
+const char* toString(NMEAFieldStatus status)
+{
+    switch (status) {
+    case NMEAFieldStatus::Ok:         return "OK";
+    case NMEAFieldStatus::Empty:      return "EMPTY";
+    case NMEAFieldStatus::Invalid:    return "INVALID";
+    case NMEAFieldStatus::OutOfRange: return "OUT_OF_RANGE";
+    case NMEAFieldStatus::Missing:    return "MISSING";
+    }
+    return "UNKNOWN_FIELD_STATUS";
+}
+
+NMEAFieldStatus parseNMEAInt(std::string_view field, int& value)
+{
+    field = skipLeadingSpaces(field);
+    if (field.empty())
+        return NMEAFieldStatus::Empty;
+
+    bool negative;
+    std::uint64_t magnitude = 0;
+    NMEAFieldStatus status = parseInteger(field, true, negative, magnitude);
+    if (status != NMEAFieldStatus::Ok)
+        return status;
+
+    const std::uint64_t limit = negative ? static_cast<std::uint64_t>(INT_MAX) + 1 : INT_MAX;
+    if (magnitude > limit)
+        return NMEAFieldStatus::OutOfRange;
+
+    value = negative ? static_cast<int>(-static_cast<std::int64_t>(magnitude)) : static_cast<int>(magnitude);
+    return NMEAFieldStatus::Ok;
+}
+
+NMEAFieldStatus parseNMEAUnsigned(std::string_view field, unsigned int& value)
+{
+    field = skipLeadingSpaces(field);
+    if (field.empty())
+        return NMEAFieldStatus::Empty;
+
+    bool negative;
+    std::uint64_t magnitude = 0;
+    NMEAFieldStatus status = parseInteger(field, false, negative, magnitude);
+    if (status != NMEAFieldStatus::Ok)
+        return status;
+
+    if (magnitude > UINT_MAX)
+        return NMEAFieldStatus::OutOfRange;
+
+    value = static_cast<unsigned int>(magnitude);
+    return NMEAFieldStatus::Ok;
+}
+
+NMEAFieldStatus parseNMEADouble(std::string_view field, double& value)
+{
+    field = skipLeadingSpaces(field);
+    if (field.empty())
+        return NMEAFieldStatus::Empty;
+
+    std::string_view number = field;
+    bool negative = field[0] == '-';
+    if (negative || field[0] == '+')
+        field.remove_prefix(1);
+
+    // One pass: digits accumulate into the mantissa, the '.' only marks where the
+    // fraction starts.
+    std::uint64_t mantissa = 0;
+    std::size_t digits = 0;
+    std::size_t dot = std::string_view::npos;
+    for (std::size_t i = 0; i < field.size(); ++i)
+    {
+        char c = field[i];
+        if (isDigit(c))
+        {
+            mantissa = mantissa * 10 + static_cast<unsigned>(c - '0');
+            digits++;
+        }
+        else if (c == '.' && dot == std::string_view::npos)
+        {
+            dot = i;
+        }
+        else
+        {
+            return NMEAFieldStatus::Invalid;
+        }
+    }
+
+    if (digits == 0)
+        return NMEAFieldStatus::Invalid;
+
+    // Fast path: every digit fits in a 53 bit mantissa and the scale is an exact power of
+    // ten, so one correctly rounded division gives the correctly rounded result.
+    if (digits <= 15)
+    {
+        const std::size_t fractionDigits = dot == std::string_view::npos ? 0 : field.size() - dot - 1;
+        double d = static_cast<double>(mantissa) / PowersOf10[fractionDigits];
+        value = negative ? -d : d;
+        return NMEAFieldStatus::Ok;
+    }
+
+    // Long numbers: std::from_chars is also locale-free and bounded. It does not take '+'.
+    if (number[0] == '+')
+        number.remove_prefix(1);
+    double d = 0.0;
+    auto result = std::from_chars(number.data(), number.data() + number.size(), d, std::chars_format::fixed);
+    if (result.ec == std::errc::result_out_of_range)
+        return NMEAFieldStatus::OutOfRange;
+    if (result.ec != std::errc() || result.ptr != number.data() + number.size())
+        return NMEAFieldStatus::Invalid;
+
+    value = d;
+    return NMEAFieldStatus::Ok;
+}
+
+NMEAFieldStatus parseNMEAHex(std::string_view field, std::uint32_t& value)
+{
+    field = skipLeadingSpaces(field);
+    if (field.empty())
+        return NMEAFieldStatus::Empty;
+
+    if (field.size() > 2 && field[0] == '0' && (field[1] == 'x' || field[1] == 'X'))
+        field.remove_prefix(2);
+
+    std::uint64_t v = 0;
+    for (char c : field)
+    {
+        unsigned digit;
+        if (isDigit(c))
+            digit = static_cast<unsigned>(c - '0');
+        else if (c >= 'A' && c <= 'F')
+            digit = static_cast<unsigned>(c - 'A' + 10);
+        else if (c >= 'a' && c <= 'f')
+            digit = static_cast<unsigned>(c - 'a' + 10);
+        else
+            return NMEAFieldStatus::Invalid;
+
+        v = (v << 4) | digit;
+        if (v > UINT32_MAX)
+            return NMEAFieldStatus::OutOfRange;
+    }
+
+    value = static_cast<std::uint32_t>(v);
+    return NMEAFieldStatus::Ok;
+}
@@ -0,0 +1,52 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2025 Mark Wilson
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+//  https://www.boost.org/LICENSE_1_0.txt)
+//-----------------------------------------------------------------------------
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+/**
+ * @brief The NMEAFieldStatus enum is the outcome of extracting one field.
+ */
+enum class NMEAFieldStatus : std::uint8_t
+{
+    Ok = 0,
+    Empty,      ///< The field is present but has no characters (",,")
+    Invalid,    ///< Characters that do not fit the field's numeric grammar
+    OutOfRange, ///< A well formed number that does not fit the target type
+    Missing     ///< The sentence has fewer fields than were extracted
+};
+
+const char* toString(NMEAFieldStatus status);
+
+//
+// Locale-free parsers for the NMEA numeric grammar. They read exactly field.size()
+// characters (no NUL terminator needed), skip leading spaces and reject anything else
+// that is not part of the number, including trailing characters.
+//
+
+/**
+ * @brief parseNMEAInt parses [+-]digits.
+ */
+NMEAFieldStatus parseNMEAInt(std::string_view field, int& value);
+
+/**
+ * @brief parseNMEAUnsigned parses [+]digits.
+ */
+NMEAFieldStatus parseNMEAUnsigned(std::string_view field, unsigned int& value);
+
+/**
+ * @brief parseNMEADouble parses [+-]digits[.digits] (either side of the '.' may be empty,
+ * not both). No exponents, infinities or NaNs; NMEA does not use them.
+ */
+NMEAFieldStatus parseNMEADouble(std::string_view field, double& value);
+
+/**
+ * @brief parseNMEAHex parses [0x]hexdigits, as written by NMEAInsertionStream in Hex mode.
+ */
+NMEAFieldStatus parseNMEAHex(std::string_view field, std::uint32_t& value);
@@ -0,0 +1,157 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2025 Mark Wilson
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+//  https://www.boost.org/LICENSE_1_0.txt)
+//-----------------------------------------------------------------------------
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string_view>
+
+/**
+ * @brief The NMEAMessageName class holds the 3 character message code of a sentence ("GGA")
+ * in a fixed 4 byte array. It is a literal type, so NMEATraits<T>::messageName() can
+ * produce one at compile time, and comparing or hashing two names is one integer compare.
+ * A name built from anything other than 3 non-NUL characters is invalid (all zeros).
+ */
+class NMEAMessageName
+{
+public:
+    static constexpr std::size_t Length = 3;
+
+    constexpr NMEAMessageName() = default;
+
+    constexpr NMEAMessageName(const char (&name)[Length + 1])
+        : NMEAMessageName(std::string_view(name, Length))
+    {}
+
+    constexpr explicit NMEAMessageName(std::string_view name)
+    {
+        if (name.size() == Length && name[0] && name[1] && name[2])
+        {
+            mChars[0] = name[0];
+            mChars[1] = name[1];
+            mChars[2] = name[2];
+        }
+    }
+
+    constexpr bool isValid() const { return mChars[0] != 0; }
+
+    /// @return The three characters packed little end first into one integer.
+    constexpr std::uint32_t code() const
+    {
+        return  static_cast<std::uint32_t>(static_cast<unsigned char>(mChars[0]))
+             | (static_cast<std::uint32_t>(static_cast<unsigned char>(mChars[1])) << 8)
+             | (static_cast<std::uint32_t>(static_cast<unsigned char>(mChars[2])) << 16);
+    }
+
+    constexpr std::string_view view() const { return std::string_view(mChars, isValid() ? Length : 0); }
+
+    constexpr const char* c_str() const { return mChars; }
+
+    friend constexpr bool operator==(NMEAMessageName a, NMEAMessageName b) { return a.code() == b.code(); }
+    friend constexpr bool operator!=(NMEAMessageName a, NMEAMessageName b) { return a.code() != b.code(); }
+    friend constexpr bool operator<(NMEAMessageName a, NMEAMessageName b) { return a.code() < b.code(); }
+
+private:
+    char mChars[Length + 1] {};
+};
+
+/**
+ * @brief The NMEAHeader class is the "$TTMMM" part of a sentence: a 2 character talker and a
+ * 3 character message name packed into 8 bytes (NUL padded). Equality and hashing work on
+ * the whole header as a single 64 bit word.
+ */
+class NMEAHeader
+{
+public:
+    static constexpr std::size_t TalkerLength = 2;
+
+    constexpr NMEAHeader() = default;
+
+    constexpr NMEAHeader(std::string_view talker, NMEAMessageName name)
+    {
+        if (talker.size() == TalkerLength && talker[0] && talker[1])
+        {
+            mChars[0] = talker[0];
+            mChars[1] = talker[1];
+        }
+        mChars[2] = name.c_str()[0];
+        mChars[3] = name.c_str()[1];
+        mChars[4] = name.c_str()[2];
+    }
+
+    /**
+     * @brief fromField builds a header from the first field of a sentence, "TTMMM".
+     */
+    static constexpr NMEAHeader fromField(std::string_view field)
+    {
+        if (field.size() != TalkerLength + NMEAMessageName::Length)
+            return NMEAHeader();
+        return NMEAHeader(field.substr(0, TalkerLength), NMEAMessageName(field.substr(TalkerLength)));
+    }
+
+    constexpr bool isTalkerValid() const { return mChars[0] != 0; }
+
+    constexpr bool isNameValid() const { return mChars[2] != 0; }
+
+    constexpr bool isValid() const { return isTalkerValid() && isNameValid(); }
+
+    constexpr std::string_view talker() const
+    {
+        return std::string_view(mChars, isTalkerValid() ? TalkerLength : 0);
+    }
+
+    constexpr std::string_view messageName() const
+    {
+        return std::string_view(mChars + TalkerLength, isNameValid() ? NMEAMessageName::Length : 0);
+    }
+
+    constexpr NMEAMessageName name() const
+    {
+        return NMEAMessageName(std::string_view(mChars + TalkerLength, NMEAMessageName::Length));
+    }
+
+    /// @return All 8 bytes of the header as one integer, first character in the low byte.
+    constexpr std::uint64_t word() const
+    {
+        std::uint64_t w = 0;
+        for (std::size_t i = 0; i < sizeof(mChars); ++i)
+            w |= static_cast<std::uint64_t>(static_cast<unsigned char>(mChars[i])) << (8 * i);
+        return w;
+    }
+
+    friend constexpr bool operator==(const NMEAHeader& a, const NMEAHeader& b) { return a.word() == b.word(); }
+    friend constexpr bool operator!=(const NMEAHeader& a, const NMEAHeader& b) { return a.word() != b.word(); }
+
+private:
+    char mChars[8] {};
+};
+
+namespace std {
+
+template <>
+struct hash<NMEAMessageName>
+{
+    std::size_t operator()(NMEAMessageName name) const noexcept
+    {
+        return std::hash<std::uint32_t>{}(name.code());
+    }
+};
+
+template <>
+struct hash<NMEAHeader>
+{
+    std::size_t operator()(const NMEAHeader& header) const noexcept
+    {
+        // Fibonacci multiply so the well-mixed high bits also land in the low bits.
+        std::uint64_t h = header.word() * 0x9E3779B97F4A7C15ull;
+        return static_cast<std::size_t>(h ^ (h >> 32));
+    }
+};
+
+} // namespace std
@@ -5,74 +5,171 @@
 // (See accompanying file LICENSE_1_0.txt or copy at
 //  https://www.boost.org/LICENSE_1_0.txt)
 //-----------------------------------------------------------------------------
+#include <charconv>
+#include <cmath>
 #include <cstring>
-#include <iostream>
-#include <stdio.h>
 
 #include "NMEAInsertionStream.h"
 #include "NMEACommon.h"
+#include "NMEAHeader.h"
 #include "Register32Bits.h"
 #include "MutableBuffer.h"
 
 using namespace std;
 
+namespace {
+
+constexpr char HexDigits[] = "0123456789ABCDEF";
+
+} // namespace
+
 NMEAInsertionStream::NMEAInsertionStream(MutableBuffer &buffer, const char *talker, const char *msg) :
     mBuffer(buffer),
     mBufferSize(buffer.size()),
+    mBegin(buffer.data()),
+    mEnd(buffer.data() + buffer.size()),
     mCurrentPtr(buffer.data()),
-    mTalker(talker),
-    mMsg(msg)
+    mPayloadStart(buffer.data())
+{
+    writeHeader(talker, msg);
+}
+
+NMEAInsertionStream::NMEAInsertionStream(MutableBuffer &buffer, const NMEAHeader &header) :
+    mBuffer(buffer),
+    mBufferSize(buffer.size()),
+    mBegin(buffer.data()),
+    mEnd(buffer.data() + buffer.size()),
+    mCurrentPtr(buffer.data()),
+    mPayloadStart(buffer.data())
+{
+    writeHeader(header.talker(), header.messageName());
+}
+
+void NMEAInsertionStream::writeHeader(std::string_view talker, std::string_view msg)
 {
+    if ( !reserve(1 + talker.size() + msg.size() + 1) )
+        return;
+
     *mCurrentPtr++ = '$';
-    strcpy((char*)mCurrentPtr, talker);
-    mCurrentPtr += strlen(talker);
-    strcpy((char*)mCurrentPtr, msg);
-    mCurrentPtr += strlen(msg);
+    std::memcpy(mCurrentPtr, talker.data(), talker.size());
+    mCurrentPtr += talker.size();
+    std::memcpy(mCurrentPtr, msg.data(), msg.size());
+    mCurrentPtr += msg.size();
     *mCurrentPtr++ = ',';
+
+    mPayloadStart = mCurrentPtr;
 }
 
 void NMEAInsertionStream::resetBuffer()
 {
-    mCurrentPtr = mBuffer.data();
+    mCurrentPtr = mPayloadStart;
+    mComplete = false;
+    mChecksum = 0;
+
+    // Only a buffer too small for the header stays overflowed
+    mOverflow = mPayloadStart == mBegin;
 }
 
-using namespace std;
+bool NMEAInsertionStream::reserve(std::size_t n)
+{
+    if ( mOverflow )
+        return false;
+
+    if ( static_cast<std::size_t>(mEnd - mCurrentPtr) < n )
+    {
+        mOverflow = true;
+        return false;
+    }
+
+    return true;
+}
+
+void NMEAInsertionStream::commitField(char *fieldEnd)
+{
+    *fieldEnd++ = ',';
+    mCurrentPtr = fieldEnd;
+}
 
 NMEAInsertionStream &NMEAInsertionStream::operator<<(int i)
 {
-    if ( mBase == 10 )
+    if ( mBase == 16 )
     {
-        std::size_t sz = sprintf((char*)mCurrentPtr, "%d,", i);
-        mLen += sz;
-        mCurrentPtr += sz;
+        // "0x%04X,"
+        char digits[8];
+        int n = 0;
+        unsigned int u = static_cast<unsigned int>(i);
+        do {
+            digits[n++] = HexDigits[u & 0xF];
+            u >>= 4;
+        } while (u);
+        while (n < 4)
+            digits[n++] = '0';
+
+        if ( !reserve(2 + n + 1) )
+            return *this;
+
+        char* p = mCurrentPtr;
+        *p++ = '0';
+        *p++ = 'x';
+        while (n)
+            *p++ = digits[--n];
+        commitField(p);
+        return *this;
     }
 
-    if ( mBase == 16 )
+    if ( !reserve(1) )
+        return *this;
+
+    // Keep the last byte for the ','
+    auto result = std::to_chars(mCurrentPtr, mEnd - 1, i);
+    if ( result.ec != std::errc() )
     {
-        std::size_t sz = sprintf((char*)mCurrentPtr, "0x%04X,", i);
-        mLen += sz;
-        mCurrentPtr += sz;
+        mOverflow = true;
+        return *this;
     }
+    commitField(result.ptr);
 
     return *this;
 }
 
 NMEAInsertionStream &NMEAInsertionStream::operator<<(double d)
 {
-    std::size_t sz = sprintf((char*)mCurrentPtr, "%f,", d);
-    mLen += sz;
-    mCurrentPtr += sz;
+    // NaN is what NMEAExtractionStream yields for an empty field; write it back as one
+    if ( std::isnan(d) )
+        return *this << EmptyField();
+
+    if ( !reserve(1) )
+        return *this;
+
+    auto result = std::to_chars(mCurrentPtr, mEnd - 1, d, std::chars_format::fixed, mPrecision);
+    if ( result.ec != std::errc() )
+    {
+        mOverflow = true;
+        return *this;
+    }
+    commitField(result.ptr);
 
     return *this;
 }
 
 NMEAInsertionStream &NMEAInsertionStream::operator<<(const std::string &s)
+{
+    return *this << std::string_view(s);
+}
+
+NMEAInsertionStream &NMEAInsertionStream::operator<<(const char *s)
+{
+    return *this << std::string_view(s);
+}
+
+NMEAInsertionStream &NMEAInsertionStream::operator<<(std::string_view s)
 {
     std::size_t sz = s.size();
-    std::copy(s.begin(), s.end(), mCurrentPtr);
-    mCurrentPtr += sz;
-    *mCurrentPtr++ = ',';
-    mLen += sz+1;
+    if ( !reserve(sz + 1) )
+        return *this;
+
+    std::memcpy(mCurrentPtr, s.data(), sz);
+    commitField(mCurrentPtr + sz);
 
     return *this;
 }
@@ -88,16 +185,17 @@ NMEAInsertionStream &NMEAInsertionStream::operator<<(const Register32Bits &reg)
 
 NMEAInsertionStream& NMEAInsertionStream::operator<<(EmptyField ef)
 {
-    *mCurrentPtr = ',';
-    mLen += 1;
-    mCurrentPtr++;
+    if ( !reserve(1) )
+        return *this;
+
+    commitField(mCurrentPtr);
 
    return *this;
 }
 
 NMEAInsertionStream& NMEAInsertionStream::operator<<(const FloatFormat& fmt)
 {
-    mFloatFormat = fmt.format;
+    mPrecision = fmt.precision < 0 ? 0 : fmt.precision;
 
     return *this;
 }
@@ -118,18 +216,30 @@ NMEAInsertionStream &NMEAInsertionStream::operator<<(const Dec &hex)
 
 NMEAInsertionStream& NMEAInsertionStream::operator<<(const EndMsg& end)
 {
-    mCurrentPtr--;
-    *mCurrentPtr = 0;
+    if ( mOverflow || mComplete )
+        return *this;
+
+    // The trailing ',' becomes the '*' of "*HH\r\n"
+    char* star = mCurrentPtr - 1;
+    if ( mEnd - star < 5 )
+    {
+        mOverflow = true;
+        return *this;
+    }
 
-    std::int8_t cs = calculateNMEAChecksum(mBuffer.data());
+    mChecksum = xorNMEABytes(std::string_view(mBegin + 1, static_cast<std::size_t>(star - mBegin - 1)));
 
-    sprintf(mCurrentPtr, "*%xc", cs);
-    mCurrentPtr += 3;
+    star[0] = '*';
+    star[1] = HexDigits[mChecksum >> 4];
+    star[2] = HexDigits[mChecksum & 0xF];
+    star[3] = '\r';
+    star[4] = '\n';
+    mCurrentPtr = star + 5;
 
-    strcpy((char*)mCurrentPtr, "\r\n");
-    mCurrentPtr += 2;
+    if ( mCurrentPtr < mEnd )
+        *mCurrentPtr = 0;
 
-    printf("s: %s\n", mBuffer.data());
+    mComplete = true;
 
     return *this;
 }
@@ -9,26 +9,35 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <stdint.h>
+#include <type_traits>
 
 #include "traits.h"
 
 class MutableBuffer;
+class NMEAHeader;
 class Register32Bits;
 
 /**
  * @brief The NMEAInsertionStream class serializes integers,floating point,
  * and string values as NMEA fields in an NMEA message string.
+ *
+ * Numbers are formatted with std::to_chars and hand written digit loops, never past the
+ * end of the MutableBuffer. A write that does not fit sets overflowed() and the stream
+ * ignores everything after it, so the buffer never holds a partial field. The stream
+ * performs no I/O.
  */
 class NMEAInsertionStream
 {
 public:
     /**
-     * @brief The FloatFormat struct is an NMEAInsertionStream manipulator.
+     * @brief The FloatFormat struct is an NMEAInsertionStream manipulator. It sets how many
+     * digits follow the decimal point of every double inserted after it.
      */
     struct FloatFormat
     {
-        std::string format = "%01f";
+        int precision = 6;
     };
 
     /**
@@ -50,7 +59,8 @@ public:
     /**
      * @brief The EndMsg struct is an NMEAInsertionStream manipulator. The struct is empty
      * and used only as a tag.  It causes the NMEAInsertionStream class to calculate the
-     * checksum, and ensures there are no trailing ',' characters.
+     * checksum, and ensures there are no trailing ',' characters. The sentence ends in
+     * "*HH\r\n", followed by a NUL if there is room for one (not counted in size()).
      */
     struct EndMsg {};
 
@@ -60,6 +70,8 @@ public:
 
     NMEAInsertionStream(MutableBuffer& buffer, const char *talker, const char *msg);
 
+    NMEAInsertionStream(MutableBuffer& buffer, const NMEAHeader& header);
+
     NMEAInsertionStream& operator<<(const FloatFormat& fmt);
 
     NMEAInsertionStream& operator<<(const Hex& hex);
@@ -74,6 +86,10 @@ public:
 
     NMEAInsertionStream& operator<<(const std::string &s);
 
+    NMEAInsertionStream& operator<<(std::string_view s);
+
+    NMEAInsertionStream& operator<<(const char *s);
+
     NMEAInsertionStream &operator<<(const Register32Bits &reg);
 
     NMEAInsertionStream &operator<<(EmptyField ef);
@@ -87,22 +103,59 @@ public:
     typename std::enable_if<is_scoped_enum<T>::value, NMEAInsertionStream&>::type
     operator<<(T enumerator)
     {
-        std::size_t sz = sprintf(mCurrentPtr, "%d,", static_cast<T>(enumerator));
-        mLen += sz;
-        mCurrentPtr += sz;
-
-        return *this;
+        return *this << static_cast<int>(static_cast<typename std::underlying_type<T>::type>(enumerator));
     }
 
+    /**
+     * @brief resetBuffer rewinds to just after the "$TTMMM," header and clears overflowed().
+     */
     void resetBuffer();
 
+    /**
+     * @brief overflowed
+     * @return true if a write did not fit in the buffer; the sentence is incomplete.
+     */
+    bool overflowed() const { return mOverflow; }
+
+    /**
+     * @brief size
+     * @return Bytes written so far, header and (after EndMsg) trailer included.
+     */
+    std::size_t size() const { return static_cast<std::size_t>(mCurrentPtr - mBegin); }
+
+    /**
+     * @brief isComplete
+     * @return true once EndMsg has been written without overflowing.
+     */
+    bool isComplete() const { return mComplete && !mOverflow; }
+
+    /**
+     * @brief checksum
+     * @return The checksum written by EndMsg, 0 before that.
+     */
+    std::uint8_t checksum() const { return mChecksum; }
+
 private:
     MutableBuffer& mBuffer;
     std::size_t mBufferSize;
+    char* mBegin;
+    char* mEnd;
     char* mCurrentPtr;
-    uint32_t mLen {0};
-    const char* mTalker;
-    const char* mMsg;
-    std::string mFloatFormat { "%0.1f" };
+    char* mPayloadStart;
+    int mPrecision {6};
     std::uint8_t mBase{10};
+    std::uint8_t mChecksum{0};
+    bool mOverflow{false};
+    bool mComplete{false};
+
+    /**
+     * @brief reserve
+     * @return true if n more bytes fit; otherwise marks the stream overflowed.
+     */
+    bool reserve(std::size_t n);
+
+    void writeHeader(std::string_view talker, std::string_view msg);
+
+    // Commits a field that was formatted at mCurrentPtr, appending its ','.
+    void commitField(char* fieldEnd);
 };
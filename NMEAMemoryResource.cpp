@@ -0,0 +1,23 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2025 Mark Wilson
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+//  https://www.boost.org/LICENSE_1_0.txt)
+//-----------------------------------------------------------------------------
+#include "NMEAMemoryResource.h"
+
+std::pmr::pool_options nmeaMessagePoolOptions()
+{
+    std::pmr::pool_options options;
+    options.max_blocks_per_chunk = 256;
+    options.largest_required_pool_block = 1024;
+    return options;
+}
+
+std::pmr::memory_resource* threadLocalNMEAMessageResource()
+{
+    thread_local std::pmr::unsynchronized_pool_resource pool(nmeaMessagePoolOptions(),
+                                                             std::pmr::new_delete_resource());
+    return &pool;
+}
@@ -0,0 +1,27 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2025 Mark Wilson
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+//  https://www.boost.org/LICENSE_1_0.txt)
+//-----------------------------------------------------------------------------
+#pragma once
+
+#include <memory_resource>
+
+/**
+ * @brief nmeaMessagePoolOptions are the pool settings used by threadLocalNMEAMessageResource():
+ * pools up to 1 KiB blocks, comfortably above AnyNMEAMessage::InlineCapacity, which is where
+ * payloads start leaving the inline buffer. Anything larger goes to the upstream resource.
+ */
+std::pmr::pool_options nmeaMessagePoolOptions();
+
+/**
+ * @brief threadLocalNMEAMessageResource returns this thread's unsynchronized pool for
+ * AnyNMEAMessage payloads, so churning through messages costs no global heap lock.
+ *
+ * A message allocated from it must be destroyed (or assigned over) on the same thread, and
+ * before that thread exits, when the pool releases everything back to the global heap.
+ * Copy such a message (the copy uses the default resource) to hand it to another thread.
+ */
+std::pmr::memory_resource* threadLocalNMEAMessageResource();
@@ -0,0 +1,405 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2025 Mark Wilson
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+//  https://www.boost.org/LICENSE_1_0.txt)
+//-----------------------------------------------------------------------------
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+#include "AnyNMEAMessage.h"
+
+/**
+ * @brief nmeaCpuRelax tells the CPU the thread is busy waiting.
+ */
+inline void nmeaCpuRelax() noexcept
+{
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+    asm volatile("yield");
+#endif
+}
+
+/**
+ * @brief The NMEASpinWait struct is a queue wait strategy that never sleeps: it spins with a
+ * pause instruction and, after SpinsBeforeYield rounds, yields the CPU between checks.
+ * Lowest hand-over latency, but a waiting thread keeps a core busy.
+ */
+struct NMEASpinWait
+{
+    static constexpr int SpinsBeforeYield = 64;
+
+    template <class Ready>
+    void wait(Ready ready)
+    {
+        for (int spins = 0; !ready(); ++spins)
+        {
+            if (spins < SpinsBeforeYield)
+                nmeaCpuRelax();
+            else
+                std::this_thread::yield();
+        }
+    }
+
+    void notify() noexcept {}
+};
+
+/**
+ * @brief The NMEABlockingWait class is a queue wait strategy that spins briefly and then
+ * sleeps on a condition variable. notify() is one atomic load unless somebody is asleep, so
+ * the queue's fast path stays lock-free.
+ */
+class NMEABlockingWait
+{
+public:
+    static constexpr int SpinsBeforeSleep = 128;
+
+    template <class Ready>
+    void wait(Ready ready)
+    {
+        for (int spins = 0; spins < SpinsBeforeSleep; ++spins)
+        {
+            if (ready())
+                return;
+            nmeaCpuRelax();
+        }
+
+        std::unique_lock<std::mutex> lock(mMutex);
+        mSleepers.fetch_add(1, std::memory_order_seq_cst);
+        // Pairs with the fence in notify(): either the notifier sees the sleeper, or this
+        // check sees what the notifier published
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        mWake.wait(lock, ready);
+        mSleepers.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    void notify()
+    {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (mSleepers.load(std::memory_order_relaxed) == 0)
+            return;
+
+        // Taking the lock orders this notify after a sleeper's last check of ready()
+        { std::lock_guard<std::mutex> lock(mMutex); }
+        mWake.notify_all();
+    }
+
+private:
+    std::mutex mMutex;
+    std::condition_variable mWake;
+    std::atomic<int> mSleepers {0};
+};
+
+/// @return The ring size the queues below use for a requested capacity: a power of two, at least 2.
+inline std::size_t nmeaQueueCapacity(std::size_t requested)
+{
+    std::size_t p = 2;
+    while (p < requested)
+        p <<= 1;
+    return p;
+}
+
+/**
+ * @brief The NMEASPSCQueue class is a bounded, lock-free single producer, single consumer
+ * ring for handing messages from one thread to another.
+ *
+ * Elements are move constructed into uninitialized slots, so an AnyNMEAMessage travels
+ * with its payload and memory resource, and move assigned into the caller's object on pop,
+ * which hands the payload over without allocating when both use equal memory resources
+ * (always, with the default one). Nothing else is allocated after construction. Producer
+ * and consumer indices sit on separate cache lines and each side keeps a cached copy of
+ * the other's, so in steady state a push or pop touches no cache line the other thread
+ * writes. Batch operations publish once per batch.
+ *
+ * Exactly one thread may push and one thread may pop at a time.
+ *
+ * @tparam Wait NMEASpinWait or NMEABlockingWait, used by the blocking push() and pop().
+ */
+template <class T = AnyNMEAMessage, class Wait = NMEASpinWait>
+class NMEASPSCQueue
+{
+    static_assert(std::is_nothrow_move_constructible<T>::value, "Queue elements must be nothrow move constructible");
+
+public:
+    /// @param capacity Rounded up by nmeaQueueCapacity().
+    explicit NMEASPSCQueue(std::size_t capacity) :
+        mMask(nmeaQueueCapacity(capacity) - 1),
+        mSlots(new Slot[mMask + 1])
+    {
+    }
+
+    ~NMEASPSCQueue()
+    {
+        T discard;
+        while (tryPop(discard)) {}
+    }
+
+    NMEASPSCQueue(const NMEASPSCQueue&) = delete;
+    NMEASPSCQueue& operator=(const NMEASPSCQueue&) = delete;
+
+    std::size_t capacity() const { return mMask + 1; }
+
+    /// @return Elements queued; exact only when called by the producer or consumer.
+    std::size_t sizeApprox() const
+    {
+        return mTail.load(std::memory_order_acquire) - mHead.load(std::memory_order_acquire);
+    }
+
+    /// @return false, leaving value untouched, if the queue is full.
+    bool tryPush(T&& value)
+    {
+        return tryPushBatch(&value, 1) == 1;
+    }
+
+    /**
+     * @brief tryPushBatch moves as many of values[0..count) as fit, in order.
+     * @return How many were moved in; the rest are left untouched.
+     */
+    std::size_t tryPushBatch(T* values, std::size_t count)
+    {
+        const std::size_t tail = mTail.load(std::memory_order_relaxed);
+        if (tail + count - mHeadCache > capacity())
+            mHeadCache = mHead.load(std::memory_order_acquire);
+
+        const std::size_t n = std::min(count, capacity() - (tail - mHeadCache));
+        for (std::size_t i = 0; i < n; ++i)
+            ::new (mSlots[(tail + i) & mMask].address()) T(std::move(values[i]));
+
+        if (n > 0)
+        {
+            mTail.store(tail + n, std::memory_order_release);
+            mNotEmpty.notify();
+        }
+        return n;
+    }
+
+    /// @return false, leaving out untouched, if the queue is empty.
+    bool tryPop(T& out)
+    {
+        return tryPopBatch(&out, 1) == 1;
+    }
+
+    /**
+     * @brief tryPopBatch moves up to count elements, oldest first, into out[0..) by move
+     * assignment.
+     * @return How many were popped.
+     */
+    std::size_t tryPopBatch(T* out, std::size_t count)
+    {
+        const std::size_t head = mHead.load(std::memory_order_relaxed);
+        if (mTailCache - head < count)
+            mTailCache = mTail.load(std::memory_order_acquire);
+
+        const std::size_t n = std::min(count, mTailCache - head);
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            T* slot = mSlots[(head + i) & mMask].value();
+            out[i] = std::move(*slot);
+            slot->~T();
+        }
+
+        if (n > 0)
+        {
+            mHead.store(head + n, std::memory_order_release);
+            mNotFull.notify();
+        }
+        return n;
+    }
+
+    /// @brief push waits, as Wait says, until there is room.
+    void push(T&& value)
+    {
+        while (!tryPush(std::move(value)))
+            mNotFull.wait([this] { return sizeApprox() < capacity(); });
+    }
+
+    /// @brief pop waits, as Wait says, until there is an element.
+    void pop(T& out)
+    {
+        while (!tryPop(out))
+            mNotEmpty.wait([this] { return sizeApprox() > 0; });
+    }
+
+private:
+    struct Slot
+    {
+        alignas(T) unsigned char storage[sizeof(T)];
+
+        void* address() { return storage; }
+        T* value() { return std::launder(reinterpret_cast<T*>(storage)); }
+    };
+
+    const std::size_t mMask;
+    std::unique_ptr<Slot[]> mSlots;
+
+    alignas(64) std::atomic<std::size_t> mTail {0}; // written by the producer
+    std::size_t mHeadCache {0};                     // producer's last view of mHead
+
+    alignas(64) std::atomic<std::size_t> mHead {0}; // written by the consumer
+    std::size_t mTailCache {0};                     // consumer's last view of mTail
+
+    alignas(64) Wait mNotEmpty;
+    Wait mNotFull;
+};
+
+/**
+ * @brief The NMEAMPMCQueue class is a bounded, lock-free multi producer, multi consumer
+ * ring (Dmitry Vyukov's design): every cell carries a sequence number telling whether it
+ * is ready to be written or read for a given lap, so producers and consumers each claim a
+ * position with a single CAS and never wait on one another except when full or empty.
+ *
+ * Elements move in and out as with NMEASPSCQueue. Batch operations claim one cell at a time
+ * and stop at the first that is not available, so a batch may interleave with other
+ * threads' elements.
+ *
+ * @tparam Wait NMEASpinWait or NMEABlockingWait, used by the blocking push() and pop().
+ */
+template <class T = AnyNMEAMessage, class Wait = NMEASpinWait>
+class NMEAMPMCQueue
+{
+    static_assert(std::is_nothrow_move_constructible<T>::value, "Queue elements must be nothrow move constructible");
+
+public:
+    /// @param capacity Rounded up by nmeaQueueCapacity().
+    explicit NMEAMPMCQueue(std::size_t capacity) :
+        mMask(nmeaQueueCapacity(capacity) - 1),
+        mCells(new Cell[mMask + 1])
+    {
+        for (std::size_t i = 0; i <= mMask; ++i)
+            mCells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    ~NMEAMPMCQueue()
+    {
+        T discard;
+        while (tryPop(discard)) {}
+    }
+
+    NMEAMPMCQueue(const NMEAMPMCQueue&) = delete;
+    NMEAMPMCQueue& operator=(const NMEAMPMCQueue&) = delete;
+
+    std::size_t capacity() const { return mMask + 1; }
+
+    /// @return Elements queued at some recent instant.
+    std::size_t sizeApprox() const
+    {
+        const std::size_t tail = mEnqueuePos.load(std::memory_order_acquire);
+        const std::size_t head = mDequeuePos.load(std::memory_order_acquire);
+        return tail > head ? tail - head : 0;
+    }
+
+    /// @return false, leaving value untouched, if the queue is full.
+    bool tryPush(T&& value)
+    {
+        std::size_t position;
+        Cell* cell = claim(mEnqueuePos, 0, position);
+        if (!cell)
+            return false;
+
+        ::new (cell->address()) T(std::move(value));
+        cell->sequence.store(position + 1, std::memory_order_release);
+        mNotEmpty.notify();
+        return true;
+    }
+
+    std::size_t tryPushBatch(T* values, std::size_t count)
+    {
+        std::size_t n = 0;
+        while (n < count && tryPush(std::move(values[n])))
+            ++n;
+        return n;
+    }
+
+    /// @return false, leaving out untouched, if the queue is empty.
+    bool tryPop(T& out)
+    {
+        std::size_t position;
+        Cell* cell = claim(mDequeuePos, 1, position);
+        if (!cell)
+            return false;
+
+        T* value = cell->value();
+        out = std::move(*value);
+        value->~T();
+        // Ready for the push one lap later
+        cell->sequence.store(position + mMask + 1, std::memory_order_release);
+        mNotFull.notify();
+        return true;
+    }
+
+    std::size_t tryPopBatch(T* out, std::size_t count)
+    {
+        std::size_t n = 0;
+        while (n < count && tryPop(out[n]))
+            ++n;
+        return n;
+    }
+
+    void push(T&& value)
+    {
+        while (!tryPush(std::move(value)))
+            mNotFull.wait([this] { return sizeApprox() < capacity(); });
+    }
+
+    void pop(T& out)
+    {
+        while (!tryPop(out))
+            mNotEmpty.wait([this] { return sizeApprox() > 0; });
+    }
+
+private:
+    struct alignas(64) Cell
+    {
+        std::atomic<std::size_t> sequence;
+        alignas(T) unsigned char storage[sizeof(T)];
+
+        void* address() { return storage; }
+        T* value() { return std::launder(reinterpret_cast<T*>(storage)); }
+    };
+
+    // Claims the next position from pos. A cell is ready for a push at position p when its
+    // sequence is p, and for a pop when it is p + 1 (lag).
+    Cell* claim(std::atomic<std::size_t>& pos, std::size_t lag, std::size_t& claimed)
+    {
+        std::size_t p = pos.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            Cell& cell = mCells[p & mMask];
+            const std::size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(p + lag);
+            if (diff == 0)
+            {
+                if (pos.compare_exchange_weak(p, p + 1, std::memory_order_relaxed))
+                {
+                    claimed = p;
+                    return &cell;
+                }
+            }
+            else if (diff < 0)
+                return nullptr; // full (push) or empty (pop)
+            else
+                p = pos.load(std::memory_order_relaxed);
+        }
+    }
+
+    const std::size_t mMask;
+    std::unique_ptr<Cell[]> mCells;
+
+    alignas(64) std::atomic<std::size_t> mEnqueuePos {0};
+    alignas(64) std::atomic<std::size_t> mDequeuePos {0};
+
+    alignas(64) Wait mNotEmpty;
+    Wait mNotFull;
+};
@@ -0,0 +1,340 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2025 Mark Wilson
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+//  https://www.boost.org/LICENSE_1_0.txt)
+//-----------------------------------------------------------------------------
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+
+#include "AnyNMEAMessage.h"
+#include "ImmutableBuffer.h"
+#include "NMEACommon.h"
+#include "NMEADecodeStats.h"
+#include "NMEAExceptions.h"
+#include "NMEAExtractionStream.h"
+#include "NMEAHeader.h"
+
+/**
+ * @brief The NMEAMessageRegistry class maps the message name of a raw sentence to one of
+ * the message types it was instantiated with and decodes the sentence into an AnyNMEAMessage.
+ *
+ * The lookup table is built at compile time from NMEATraits<T>::messageName() (which must be
+ * constexpr). Names are placed with a multiplicative perfect hash, so a lookup is one multiply,
+ * one shift and one integer compare. Registering two types with the same name does not compile.
+ * Every decode counts its outcome in the per-thread statistics of NMEADecodeStats.h.
+ *
+ * @code
+ * using Registry = NMEAMessageRegistry<GGAMessage, RMCMessage>;
+ * AnyNMEAMessage m = Registry::decode(ImmutableBuffer(raw, len));
+ * if (m.isType<GGAMessage>()) ...
+ * @endcode
+ */
+template <class... Messages>
+class NMEAMessageRegistry
+{
+public:
+    using Decoder = AnyNMEAMessage (*)(const NMEAHeader& header, NMEAExtractionStream& stream,
+                                       std::pmr::memory_resource* resource);
+
+    static constexpr std::size_t size() noexcept { return sizeof...(Messages); }
+
+    /// @return The decoder registered for name, or nullptr.
+    static constexpr Decoder find(NMEAMessageName name) noexcept
+    {
+        return find(name, &Entry::decoder);
+    }
+
+    static constexpr bool contains(NMEAMessageName name) noexcept { return find(name) != nullptr; }
+
+    /// @return The position of name's type in Messages..., or size() if it is not registered.
+    static constexpr std::size_t indexOf(NMEAMessageName name) noexcept
+    {
+        const Entry& entry = Table[slot(name.code())];
+        return entry.code == name.code() && name.isValid() ? entry.index : size();
+    }
+
+    /**
+     * @brief decode extracts the payload of an already parsed sentence.
+     * @param resource Where the message allocates a payload too large to store inline.
+     * @return The decoded message, or an empty AnyNMEAMessage if the header is malformed,
+     * the message name is not registered or a field does not parse.
+     */
+    static AnyNMEAMessage decode(NMEAExtractionStream& stream,
+                                 std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+    {
+        return decodeWith(&Entry::decoder, stream, resource);
+    }
+
+    static AnyNMEAMessage decode(const ImmutableBuffer& sentence,
+                                 std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+    {
+        NMEAExtractionStream stream(sentence);
+        return decode(stream, resource);
+    }
+
+    /**
+     * @brief decode is the checked form: unlike decode(stream) it also rejects sentences whose
+     * checksum does not match, and says why nothing was decoded. Exceptions thrown by the
+     * message type's extraction operator propagate.
+     * @param status Ok if the returned message is non-empty.
+     */
+    static AnyNMEAMessage decode(NMEAExtractionStream& stream, NMEADecodeStatus& status,
+                                 std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+    {
+        return decodeWith(&Entry::decoder, stream, status, resource);
+    }
+
+    /**
+     * @brief tryDecode is the checked decode for code that cannot take exceptions, or does
+     * not want to pay for unwinding on bad input: it never throws, an extraction operator
+     * that throws is reported as DecodeFailed.
+     * @param message Receives the decoded payload, allocated from message's own memory
+     * resource; left empty unless Ok is returned.
+     */
+    static NMEADecodeStatus tryDecode(NMEAExtractionStream& stream, AnyNMEAMessage& message) noexcept
+    {
+        return tryDecodeWith(&Entry::decoder, stream, message);
+    }
+
+    //
+    // Deferred decoding: the decodeDeferred overloads check and look up a sentence exactly as
+    // the matching decode overloads do, but return a deferred message (see
+    // AnyNMEAMessage::deferred()) holding a copy of the sentence, whose payload is extracted
+    // on first access. Traffic that is only filtered by type or header, or forwarded with
+    // serialize(), never pays for the field parse. A sentence rejected here is counted in
+    // the decode statistics here; a deferred one is counted once its payload is first
+    // extracted, as Ok or DecodeFailed, or as BadFraming if the lazy scan only then finds it
+    // unframed, so no sentence is counted twice. Exceptions from that extraction reach the
+    // caller of get<T>().
+    //
+
+    static AnyNMEAMessage decodeDeferred(NMEAExtractionStream& stream,
+                                         std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+    {
+        return decodeWith(&Entry::deferrer, stream, resource);
+    }
+
+    /// Binds a lazy stream (see NMEAFieldScan), so the sentence is only checked for framing.
+    static AnyNMEAMessage decodeDeferred(const ImmutableBuffer& sentence,
+                                         std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+    {
+        NMEAExtractionStream stream(NMEAFieldScan::Lazy);
+        stream.rebind(sentence);
+        return decodeDeferred(stream, resource);
+    }
+
+    static AnyNMEAMessage decodeDeferred(NMEAExtractionStream& stream, NMEADecodeStatus& status,
+                                         std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+    {
+        return decodeWith(&Entry::deferrer, stream, status, resource);
+    }
+
+    static NMEADecodeStatus tryDecodeDeferred(NMEAExtractionStream& stream, AnyNMEAMessage& message) noexcept
+    {
+        return tryDecodeWith(&Entry::deferrer, stream, message);
+    }
+
+private:
+    static_assert(sizeof...(Messages) > 0, "NMEAMessageRegistry needs at least one message type");
+
+    struct Entry
+    {
+        std::uint32_t code {0};
+        Decoder decoder {nullptr};
+        Decoder deferrer {nullptr}; ///< makes a deferred message instead
+        std::size_t index {sizeof...(Messages)};
+    };
+
+    using Kind = Decoder Entry::*; ///< &Entry::decoder or &Entry::deferrer
+
+    static constexpr Decoder find(NMEAMessageName name, Kind kind) noexcept
+    {
+        const Entry& entry = Table[slot(name.code())];
+        return entry.code == name.code() && name.isValid() ? entry.*kind : nullptr;
+    }
+
+    static AnyNMEAMessage decodeWith(Kind kind, NMEAExtractionStream& stream, std::pmr::memory_resource* resource)
+    {
+        const NMEAHeader header = stream.getHeader();
+        if (!header.isValid())
+        {
+            // An unframed sentence was already counted as such by the stream
+            if (stream.isFramed())
+                recordNMEADecode(NMEADecodeStatus::BadHeader);
+            return AnyNMEAMessage(resource);
+        }
+
+        if (Decoder decoder = find(header.name(), kind))
+            return run(decoder, header, stream, resource);
+
+        recordNMEADecode(NMEADecodeStatus::UnknownType, header.name());
+        return AnyNMEAMessage(resource);
+    }
+
+    static AnyNMEAMessage decodeWith(Kind kind, NMEAExtractionStream& stream, NMEADecodeStatus& status,
+                                     std::pmr::memory_resource* resource)
+    {
+        const NMEAHeader header = stream.getHeader();
+
+        // First: on a lazy stream this finishes the scan, which may yet find the sentence
+        // unframed (and count it as such)
+        const bool checksumValid = stream.isChecksumValid();
+        if (!stream.isFramed())
+        {
+            status = NMEADecodeStatus::BadFraming;
+            return AnyNMEAMessage(resource);
+        }
+
+        if (!checksumValid)
+            status = NMEADecodeStatus::BadChecksum;
+        else if (!header.isValid())
+            status = NMEADecodeStatus::BadHeader;
+        else if (Decoder decoder = find(header.name(), kind))
+        {
+            AnyNMEAMessage message = run(decoder, header, stream, resource);
+            status = message.isEmpty() ? NMEADecodeStatus::DecodeFailed : NMEADecodeStatus::Ok;
+            return message;
+        }
+        else
+            status = NMEADecodeStatus::UnknownType;
+
+        recordNMEADecode(status, status == NMEADecodeStatus::UnknownType ? header.name() : NMEAMessageName());
+        return AnyNMEAMessage(resource);
+    }
+
+    static NMEADecodeStatus tryDecodeWith(Kind kind, NMEAExtractionStream& stream, AnyNMEAMessage& message) noexcept
+    {
+        NMEADecodeStatus status = NMEADecodeStatus::DecodeFailed;
+        NMEA_TRY
+        {
+            message = decodeWith(kind, stream, status, message.getMemoryResource());
+        }
+        NMEA_CATCH_ALL
+        {
+            message = AnyNMEAMessage(message.getMemoryResource());
+            status = NMEADecodeStatus::DecodeFailed;
+        }
+        return status;
+    }
+
+    // Calls decoder and counts the outcome in the decode statistics; an empty message from
+    // the decoder counts as DecodeFailed. A deferred message counts itself when extracted.
+    static AnyNMEAMessage run(Decoder decoder, const NMEAHeader& header, NMEAExtractionStream& stream,
+                              std::pmr::memory_resource* resource)
+    {
+        NMEA_TRY
+        {
+            NMEALatencyScope latency(NMEALatencyStage::Decode);
+            AnyNMEAMessage message = decoder(header, stream, resource);
+            if (!message.isDeferred())
+                recordNMEADecode(message.isEmpty() ? NMEADecodeStatus::DecodeFailed : NMEADecodeStatus::Ok, header.name());
+            return message;
+        }
+        NMEA_CATCH_ALL
+        {
+            recordNMEADecode(NMEADecodeStatus::DecodeFailed, header.name());
+            NMEA_RETHROW;
+        }
+        return AnyNMEAMessage(resource);
+    }
+
+    template <class T>
+    static AnyNMEAMessage decodeAs(const NMEAHeader& header, NMEAExtractionStream& stream,
+                                   std::pmr::memory_resource* resource)
+    {
+        T value {};
+        using ::operator>>; stream >> value;
+
+        // A field that was Invalid, OutOfRange or Missing: no partial payloads
+        if (!stream.good())
+            return AnyNMEAMessage(resource);
+        return AnyNMEAMessage(header, std::move(value), resource);
+    }
+
+    template <class T>
+    static AnyNMEAMessage deferAs(const NMEAHeader& header, NMEAExtractionStream& stream,
+                                  std::pmr::memory_resource* resource)
+    {
+        return AnyNMEAMessage::deferred<T>(header, stream.getSentence(), resource);
+    }
+
+    static constexpr std::array<std::uint32_t, sizeof...(Messages)> Codes {
+        NMEATraits<Messages>::messageName().code()...
+    };
+
+    static constexpr bool namesAreUnique()
+    {
+        for (std::size_t i = 0; i < Codes.size(); ++i)
+            for (std::size_t j = i + 1; j < Codes.size(); ++j)
+                if (Codes[i] == Codes[j])
+                    return false;
+        return true;
+    }
+
+    static_assert(namesAreUnique(), "Two registered message types share the same NMEATraits<T>::messageName()");
+
+    // Smallest power of two with at least four slots per registered name.
+    static constexpr unsigned tableBits()
+    {
+        unsigned bits = 1;
+        while ((std::size_t{1} << bits) < 4 * sizeof...(Messages))
+            ++bits;
+        return bits;
+    }
+
+    static constexpr unsigned TableBits = tableBits();
+    static constexpr std::size_t TableSize = std::size_t{1} << TableBits;
+
+    static constexpr std::size_t slot(std::uint32_t code, std::uint32_t multiplier) noexcept
+    {
+        return static_cast<std::uint32_t>(code * multiplier) >> (32 - TableBits);
+    }
+
+    static constexpr bool isPerfect(std::uint32_t multiplier)
+    {
+        std::array<bool, TableSize> used {};
+        for (auto code : Codes)
+        {
+            std::size_t s = slot(code, multiplier);
+            if (used[s])
+                return false;
+            used[s] = true;
+        }
+        return true;
+    }
+
+    // Walks odd multipliers (a Weyl sequence) until every name lands in its own slot.
+    static constexpr std::uint32_t findMultiplier()
+    {
+        std::uint32_t multiplier = 0x9E3779B1u;
+        for (unsigned attempt = 0; attempt < 100000; ++attempt, multiplier += 0x6A09E668u)
+        {
+            if (isPerfect(multiplier | 1u))
+                return multiplier | 1u;
+        }
+        return 0;
+    }
+
+    static constexpr std::uint32_t Multiplier = findMultiplier();
+    static_assert(Multiplier != 0, "No perfect hash found for the registered message names");
+
+    static constexpr std::size_t slot(std::uint32_t code) noexcept { return slot(code, Multiplier); }
+
+    static constexpr std::array<Entry, TableSize> buildTable()
+    {
+        std::array<Entry, TableSize> table {};
+        constexpr std::array<Decoder, sizeof...(Messages)> decoders { &decodeAs<Messages>... };
+        constexpr std::array<Decoder, sizeof...(Messages)> deferrers { &deferAs<Messages>... };
+        for (std::size_t i = 0; i < Codes.size(); ++i)
+            table[slot(Codes[i])] = Entry { Codes[i], decoders[i], deferrers[i], i };
+        return table;
+    }
+
+    static constexpr std::array<Entry, TableSize> Table = buildTable();
+};
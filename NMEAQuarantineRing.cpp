@@ -0,0 +1,139 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2025 Mark Wilson
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+//  https://www.boost.org/LICENSE_1_0.txt)
+//-----------------------------------------------------------------------------
+#include <algorithm>
+#include <cstring>
+
+#include "NMEAQuarantineRing.h"
+
+namespace {
+
+std::size_t roundUpToPowerOfTwo(std::size_t n)
+{
+    std::size_t p = 1;
+    while (p < n)
+        p <<= 1;
+    return p;
+}
+
+// How often snapshot() retries a slot that keeps changing under it before skipping it
+constexpr int ReadAttempts = 4;
+
+} // namespace
+
+NMEAQuarantineRing::NMEAQuarantineRing(std::size_t capacity) :
+    mSlots(new Slot[roundUpToPowerOfTwo(std::max<std::size_t>(capacity, 1))]),
+    mMask(roundUpToPowerOfTwo(std::max<std::size_t>(capacity, 1)) - 1)
+{
+}
+
+bool NMEAQuarantineRing::push(std::string_view sentence, NMEADecodeStatus reason) noexcept
+{
+    const std::uint64_t sequence = mHead.fetch_add(1, std::memory_order_relaxed);
+    Slot& slot = mSlots[sequence & mMask];
+
+    // Take the slot by making its version odd; if another writer has it, drop this sentence
+    std::uint32_t version = slot.version.load(std::memory_order_relaxed);
+    if ((version & 1) != 0 ||
+        !slot.version.compare_exchange_strong(version, version + 1, std::memory_order_acquire,
+                                              std::memory_order_relaxed))
+    {
+        mDropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    // Keep the data stores below from becoming visible before the odd version; otherwise
+    // a reader could see torn words between two loads of the old, even version
+    std::atomic_thread_fence(std::memory_order_release);
+
+    // A writer that was preempted long enough for the ring to lap it must not overwrite
+    // the newer entry
+    if (slot.sequence.load(std::memory_order_relaxed) > sequence)
+    {
+        slot.version.store(version + 2, std::memory_order_release);
+        mDropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    const std::size_t length = std::min(sentence.size(), NMEAQuarantinedSentence::MaxLength);
+    char bytes[Words * 8] {};
+    std::memcpy(bytes, sentence.data(), length);
+    for (std::size_t i = 0; i < Words; ++i)
+    {
+        std::uint64_t word;
+        std::memcpy(&word, bytes + i * 8, sizeof(word));
+        slot.words[i].store(word, std::memory_order_relaxed);
+    }
+
+    const bool truncated = sentence.size() > NMEAQuarantinedSentence::MaxLength;
+    slot.info.store(static_cast<std::uint32_t>(length) | (static_cast<std::uint32_t>(truncated) << 8) |
+                    (static_cast<std::uint32_t>(reason) << 16), std::memory_order_relaxed);
+    slot.sequence.store(sequence + 1, std::memory_order_relaxed);
+
+    slot.version.store(version + 2, std::memory_order_release);
+    return true;
+}
+
+std::vector<NMEAQuarantinedSentence> NMEAQuarantineRing::snapshot() const
+{
+    std::vector<NMEAQuarantinedSentence> entries;
+    entries.reserve(capacity());
+
+    for (std::size_t s = 0; s <= mMask; ++s)
+    {
+        const Slot& slot = mSlots[s];
+        for (int attempt = 0; attempt < ReadAttempts; ++attempt)
+        {
+            const std::uint32_t before = slot.version.load(std::memory_order_acquire);
+            if ((before & 1) != 0)
+                continue;
+
+            NMEAQuarantinedSentence entry;
+            const std::uint64_t sequence = slot.sequence.load(std::memory_order_relaxed);
+            const std::uint32_t info = slot.info.load(std::memory_order_relaxed);
+            char bytes[Words * 8];
+            for (std::size_t i = 0; i < Words; ++i)
+            {
+                const std::uint64_t word = slot.words[i].load(std::memory_order_relaxed);
+                std::memcpy(bytes + i * 8, &word, sizeof(word));
+            }
+
+            // Keep the loads above from moving past the second version check
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (slot.version.load(std::memory_order_relaxed) != before)
+                continue;
+
+            if (sequence != 0)
+            {
+                entry.sequence = sequence - 1;
+                entry.length = static_cast<std::uint8_t>(info & 0xFF);
+                entry.truncated = ((info >> 8) & 1) != 0;
+                entry.reason = static_cast<NMEADecodeStatus>((info >> 16) & 0xFF);
+                std::memcpy(entry.text, bytes, entry.length);
+                entries.push_back(entry);
+            }
+            break;
+        }
+    }
+
+    std::sort(entries.begin(), entries.end(),
+              [](const NMEAQuarantinedSentence& a, const NMEAQuarantinedSentence& b) {
+                  return a.sequence < b.sequence;
+              });
+    return entries;
+}
+
+void NMEAQuarantineRing::clear()
+{
+    for (std::size_t s = 0; s <= mMask; ++s)
+    {
+        mSlots[s].sequence.store(0, std::memory_order_relaxed);
+        mSlots[s].version.store(0, std::memory_order_relaxed);
+    }
+    mHead.store(0, std::memory_order_relaxed);
+    mDropped.store(0, std::memory_order_relaxed);
+}
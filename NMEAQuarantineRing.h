@@ -0,0 +1,105 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2025 Mark Wilson
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+//  https://www.boost.org/LICENSE_1_0.txt)
+//-----------------------------------------------------------------------------
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+#include "NMEACommon.h"
+
+/**
+ * @brief The NMEAQuarantinedSentence struct is a copy of one rejected sentence.
+ */
+struct NMEAQuarantinedSentence
+{
+    static constexpr std::size_t MaxLength = 88;
+
+    std::uint64_t sequence {0};     ///< Order of arrival; the first sentence pushed is 0
+    NMEADecodeStatus reason {NMEADecodeStatus::Ok};
+    bool truncated {false};         ///< The sentence was longer than MaxLength
+    std::uint8_t length {0};
+    char text[MaxLength] {};
+
+    std::string_view view() const { return std::string_view(text, length); }
+};
+
+/**
+ * @brief The NMEAQuarantineRing class keeps the last capacity() rejected raw sentences and
+ * why they were rejected, for inspecting a noisy line after the fact.
+ *
+ * push() is lock-free and never allocates or blocks, so it can sit on the decode path of
+ * any number of threads. Each slot is a seqlock: a writer makes the slot's version odd,
+ * copies the sentence in and makes it even again; snapshot() copies a slot and keeps the
+ * copy only if the version was even and unchanged around it. A writer that finds its slot
+ * being written by another thread (the ring wrapped around faster than a copy takes) drops
+ * its sentence rather than wait, and counts it in dropped().
+ *
+ * @code
+ * NMEAQuarantineRing quarantine(256);
+ * const NMEADecodeStatus status = Registry::tryDecode(stream, message);
+ * if (status != NMEADecodeStatus::Ok)
+ *     quarantine.push(sentence, status);
+ * ...
+ * for (const auto& q : quarantine.snapshot())
+ *     std::cerr << toString(q.reason) << ": " << q.view();
+ * @endcode
+ */
+class NMEAQuarantineRing
+{
+public:
+    /// @param capacity Rounded up to a power of two, at least 1.
+    explicit NMEAQuarantineRing(std::size_t capacity = 256);
+
+    NMEAQuarantineRing(const NMEAQuarantineRing&) = delete;
+    NMEAQuarantineRing& operator=(const NMEAQuarantineRing&) = delete;
+
+    std::size_t capacity() const { return mMask + 1; }
+
+    /**
+     * @brief push records sentence as rejected for reason, overwriting the oldest entry once
+     * the ring is full. Sentences longer than NMEAQuarantinedSentence::MaxLength are cut.
+     * @return false if the sentence was dropped because its slot was busy.
+     */
+    bool push(std::string_view sentence, NMEADecodeStatus reason) noexcept;
+
+    /// @return How many sentences were ever pushed, dropped ones included.
+    std::uint64_t pushed() const { return mHead.load(std::memory_order_relaxed); }
+
+    std::uint64_t dropped() const { return mDropped.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief snapshot copies out the entries currently held, oldest first. Safe to call while
+     * other threads push; an entry overwritten during the copy is left out.
+     */
+    std::vector<NMEAQuarantinedSentence> snapshot() const;
+
+    /// @brief clear empties the ring. Not safe while other threads push.
+    void clear();
+
+private:
+    static constexpr std::size_t Words = (NMEAQuarantinedSentence::MaxLength + 7) / 8;
+
+    // Every field is atomic so readers racing a writer are well defined; relaxed accesses
+    // compile to plain loads and stores.
+    struct alignas(64) Slot
+    {
+        std::atomic<std::uint32_t> version {0};  ///< odd while being written
+        std::atomic<std::uint32_t> info {0};     ///< length | truncated << 8 | reason << 16
+        std::atomic<std::uint64_t> sequence {0}; ///< sequence + 1, 0 while never written
+        std::atomic<std::uint64_t> words[Words] {};
+    };
+
+    std::unique_ptr<Slot[]> mSlots;
+    std::size_t mMask;
+    alignas(64) std::atomic<std::uint64_t> mHead {0};
+    alignas(64) std::atomic<std::uint64_t> mDropped {0};
+};
@@ -0,0 +1,277 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2025 Mark Wilson
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+//  https://www.boost.org/LICENSE_1_0.txt)
+//-----------------------------------------------------------------------------
+#include <cstdint>
+#include <cstring>
+
+#include "NMEAScanner.h"
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__) && defined(__SSE2__)
+#define NMEA_SCANNER_X86 1
+#include <immintrin.h>
+#else
+#define NMEA_SCANNER_X86 0
+#endif
+
+namespace {
+
+constexpr std::size_t NotFound = static_cast<std::size_t>(-1);
+
+// Collects field start offsets as the kernels find ',' characters.
+struct FieldTable
+{
+    std::uint16_t* fieldStart;
+    std::size_t maxFields;
+    std::size_t count;
+    bool overflow;
+
+    void comma(std::size_t pos)
+    {
+        if (count < maxFields)
+            fieldStart[count++] = static_cast<std::uint16_t>(pos + 1);
+        else
+            overflow = true;
+    }
+};
+
+int hexValue(char c)
+{
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    return -1;
+}
+
+//
+// Each kernel scans s[1, n) up to the first '*', records commas into the table, XORs every
+// byte before the '*' into checksum and returns the '*' position (NotFound if there is none).
+//
+
+std::size_t scanScalar(const char* s, std::size_t n, FieldTable& table, std::uint8_t& checksum)
+{
+    std::uint8_t x = 0;
+    for (std::size_t pos = 1; pos < n; ++pos)
+    {
+        char c = s[pos];
+        if (c == '*')
+        {
+            checksum = x;
+            return pos;
+        }
+        if (c == ',')
+            table.comma(pos);
+        x ^= static_cast<std::uint8_t>(c);
+    }
+    checksum = x;
+    return NotFound;
+}
+
+#if NMEA_SCANNER_X86
+
+inline std::uint8_t fold(__m128i v)
+{
+    v = _mm_xor_si128(v, _mm_srli_si128(v, 8));
+    v = _mm_xor_si128(v, _mm_srli_si128(v, 4));
+    v = _mm_xor_si128(v, _mm_srli_si128(v, 2));
+    v = _mm_xor_si128(v, _mm_srli_si128(v, 1));
+    return static_cast<std::uint8_t>(_mm_cvtsi128_si32(v));
+}
+
+std::size_t scanSSE2(const char* s, std::size_t n, FieldTable& table, std::uint8_t& checksum)
+{
+    const __m128i comma = _mm_set1_epi8(',');
+    const __m128i star  = _mm_set1_epi8('*');
+    const __m128i iota  = _mm_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+    __m128i acc = _mm_setzero_si128();
+
+    for (std::size_t pos = 1; pos < n; pos += 16)
+    {
+        __m128i v;
+        if (n - pos >= 16)
+        {
+            v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + pos));
+        }
+        else
+        {
+            // Zero padding is neither ',' nor '*' and does not change the XOR.
+            alignas(16) char tail[16] = {};
+            std::memcpy(tail, s + pos, n - pos);
+            v = _mm_load_si128(reinterpret_cast<const __m128i*>(tail));
+        }
+
+        unsigned stars  = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, star)));
+        unsigned commas = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, comma)));
+
+        if (stars)
+        {
+            unsigned k = static_cast<unsigned>(__builtin_ctz(stars));
+            __m128i before = _mm_cmplt_epi8(iota, _mm_set1_epi8(static_cast<char>(k)));
+            acc = _mm_xor_si128(acc, _mm_and_si128(v, before));
+            commas &= (1u << k) - 1;
+            for (; commas; commas &= commas - 1)
+                table.comma(pos + static_cast<unsigned>(__builtin_ctz(commas)));
+            checksum = fold(acc);
+            return pos + k;
+        }
+
+        acc = _mm_xor_si128(acc, v);
+        for (; commas; commas &= commas - 1)
+            table.comma(pos + static_cast<unsigned>(__builtin_ctz(commas)));
+    }
+
+    checksum = fold(acc);
+    return NotFound;
+}
+
+__attribute__((target("avx2")))
+std::size_t scanAVX2(const char* s, std::size_t n, FieldTable& table, std::uint8_t& checksum)
+{
+    const __m256i comma = _mm256_set1_epi8(',');
+    const __m256i star  = _mm256_set1_epi8('*');
+    const __m256i iota  = _mm256_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15,
+                                           16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31);
+    __m256i acc = _mm256_setzero_si256();
+
+    for (std::size_t pos = 1; pos < n; pos += 32)
+    {
+        __m256i v;
+        if (n - pos >= 32)
+        {
+            v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + pos));
+        }
+        else
+        {
+            alignas(32) char tail[32] = {};
+            std::memcpy(tail, s + pos, n - pos);
+            v = _mm256_load_si256(reinterpret_cast<const __m256i*>(tail));
+        }
+
+        unsigned stars  = static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, star)));
+        unsigned commas = static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, comma)));
+
+        if (stars)
+        {
+            unsigned k = static_cast<unsigned>(__builtin_ctz(stars));
+            __m256i before = _mm256_cmpgt_epi8(_mm256_set1_epi8(static_cast<char>(k)), iota);
+            acc = _mm256_xor_si256(acc, _mm256_and_si256(v, before));
+            commas &= (1u << k) - 1;
+            for (; commas; commas &= commas - 1)
+                table.comma(pos + static_cast<unsigned>(__builtin_ctz(commas)));
+            checksum = fold(_mm_xor_si128(_mm256_castsi256_si128(acc), _mm256_extracti128_si256(acc, 1)));
+            return pos + k;
+        }
+
+        acc = _mm256_xor_si256(acc, v);
+        for (; commas; commas &= commas - 1)
+            table.comma(pos + static_cast<unsigned>(__builtin_ctz(commas)));
+    }
+
+    checksum = fold(_mm_xor_si128(_mm256_castsi256_si128(acc), _mm256_extracti128_si256(acc, 1)));
+    return NotFound;
+}
+
+#endif // NMEA_SCANNER_X86
+
+NMEAScanKernel detectKernel()
+{
+#if NMEA_SCANNER_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))
+        return NMEAScanKernel::AVX2;
+    return NMEAScanKernel::SSE2;
+#else
+    return NMEAScanKernel::Scalar;
+#endif
+}
+
+} // namespace
+
+NMEAScanKernel activeNMEAScanKernel()
+{
+    static const NMEAScanKernel kernel = detectKernel();
+    return kernel;
+}
+
+bool isNMEAScanKernelSupported(NMEAScanKernel kernel)
+{
+    switch (kernel) {
+    case NMEAScanKernel::Auto:
+    case NMEAScanKernel::Scalar:
+        return true;
+    case NMEAScanKernel::SSE2:
+        return NMEA_SCANNER_X86;
+    case NMEAScanKernel::AVX2:
+        return activeNMEAScanKernel() == NMEAScanKernel::AVX2;
+    }
+    return false;
+}
+
+bool scanNMEASentence(std::string_view sentence, std::uint16_t* fieldStart, std::size_t maxFields,
+                      NMEAScanResult& result, NMEAScanKernel kernel)
+{
+    result = NMEAScanResult();
+
+    const char* s = sentence.data();
+    const std::size_t n = sentence.size();
+
+    if (n == 0 || n > UINT16_MAX || s[0] != '$' || maxFields == 0)
+        return false;
+
+    FieldTable table { fieldStart, maxFields, 0, false };
+    table.fieldStart[table.count++] = 1;
+
+    if (kernel == NMEAScanKernel::Auto || !isNMEAScanKernelSupported(kernel))
+        kernel = activeNMEAScanKernel();
+
+    std::uint8_t checksum = 0;
+    std::size_t star = NotFound;
+
+    switch (kernel) {
+#if NMEA_SCANNER_X86
+    case NMEAScanKernel::AVX2:
+        star = scanAVX2(s, n, table, checksum);
+        break;
+    case NMEAScanKernel::SSE2:
+        star = scanSSE2(s, n, table, checksum);
+        break;
+#endif
+    default:
+        star = scanScalar(s, n, table, checksum);
+        break;
+    }
+
+    result.checksum = checksum;
+
+    if (table.overflow)
+    {
+        result.tooManyFields = true;
+        return false;
+    }
+
+    if (star == NotFound)
+        return false;
+
+    // Trailer is exactly "*hh" or "*hh\r\n"
+    const std::size_t trailer = n - star;
+    if (trailer == 5 && s[n - 2] == '\r' && s[n - 1] == '\n')
+        result.hasCRLF = true;
+    else if (trailer != 3)
+        return false;
+
+    int hi = hexValue(s[star + 1]);
+    int lo = hexValue(s[star + 2]);
+    if (hi < 0 || lo < 0)
+        return false;
+
+    fieldStart[table.count] = static_cast<std::uint16_t>(star + 1);
+    result.fieldCount = static_cast<std::uint16_t>(table.count);
+    result.starPos = static_cast<std::uint16_t>(star);
+    result.framed = true;
+    result.checksumValid = ((hi << 4) | lo) == checksum;
+
+    return true;
+}
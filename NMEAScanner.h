@@ -0,0 +1,61 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2025 Mark Wilson
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+//  https://www.boost.org/LICENSE_1_0.txt)
+//-----------------------------------------------------------------------------
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+/**
+ * @brief The NMEAScanKernel enum names the implementations of scanNMEASentence.
+ * Auto picks the widest one the running CPU supports.
+ */
+enum class NMEAScanKernel : std::uint8_t
+{
+    Auto,
+    Scalar,
+    SSE2,
+    AVX2
+};
+
+/**
+ * @brief The NMEAScanResult struct is everything one pass over a sentence finds out.
+ */
+struct NMEAScanResult
+{
+    bool framed {false};          ///< "$...*hh" with an optional "\r\n" and nothing else after it
+    bool hasCRLF {false};         ///< The sentence ends in "\r\n"
+    bool checksumValid {false};   ///< framed and the XOR of the payload matches the "hh" field
+    bool tooManyFields {false};   ///< More fields than the caller's table holds
+    std::uint8_t checksum {0};    ///< XOR of every byte between '$' and '*'
+    std::uint16_t starPos {0};    ///< Index of the '*'
+    std::uint16_t fieldCount {0}; ///< Fields recorded in the caller's table (header field included)
+};
+
+/**
+ * @brief scanNMEASentence walks a sentence once, recording where each ','-separated field
+ * starts, locating the '*', computing the XOR checksum and checking the "*hh\r\n" trailer.
+ *
+ * On success fieldStart[0..fieldCount] is filled: field i spans
+ * [fieldStart[i], fieldStart[i+1] - 1), the extra entry is starPos + 1. fieldStart must have
+ * room for maxFields + 1 entries. Sentences longer than UINT16_MAX are rejected.
+ *
+ * @return result.framed
+ */
+bool scanNMEASentence(std::string_view sentence, std::uint16_t* fieldStart, std::size_t maxFields,
+                      NMEAScanResult& result, NMEAScanKernel kernel = NMEAScanKernel::Auto);
+
+/**
+ * @return The kernel NMEAScanKernel::Auto resolves to on this CPU.
+ */
+NMEAScanKernel activeNMEAScanKernel();
+
+/**
+ * @return true if this build and CPU can run kernel.
+ */
+bool isNMEAScanKernelSupported(NMEAScanKernel kernel);
@@ -0,0 +1,191 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2025 Mark Wilson
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+//  https://www.boost.org/LICENSE_1_0.txt)
+//-----------------------------------------------------------------------------
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "AnyNMEAMessage.h"
+#include "NMEACommon.h"
+#include "NMEAExtractionStream.h"
+#include "NMEAInsertionStream.h"
+#include "Register32Bits.h"
+
+/**
+ * @brief The NMEAFieldFormat enum says how a schema field is written and read.
+ */
+enum class NMEAFieldFormat : std::uint8_t
+{
+    Default, ///< Whatever the stream operators do for the member's type
+    Fixed,   ///< A double with a fixed number of decimals
+    Hex      ///< An integer as "0x" and at least 4 upper case hex digits
+};
+
+/**
+ * @brief The NMEAField struct describes one field of an NMEASchema.
+ *
+ * @tparam Member    Pointer to the data member the field is read into and written from.
+ * @tparam MaxWidth  The most characters the field's value may take on the wire (without the
+ *                   separating ','). It is what the compile-time sentence bound is built
+ *                   from; the insertion stream still never writes past its buffer.
+ * @tparam Format    How the value is formatted.
+ * @tparam Precision Decimals for NMEAFieldFormat::Fixed.
+ */
+template <auto Member, std::size_t MaxWidth, NMEAFieldFormat Format = NMEAFieldFormat::Default, int Precision = 6>
+struct NMEAField
+{
+    static constexpr std::size_t Width = MaxWidth;
+    static constexpr auto MemberPointer = Member;
+
+    static_assert(std::is_member_object_pointer<decltype(Member)>::value,
+                  "NMEAField needs a pointer to a data member");
+    static_assert(MaxWidth > 0, "NMEAField MaxWidth must be at least 1");
+    static_assert(Format != NMEAFieldFormat::Fixed || (Precision >= 0 && Precision < static_cast<int>(MaxWidth)),
+                  "NMEAField Fixed precision must leave room for the integer part");
+
+    template <class T>
+    static void write(NMEAInsertionStream& stream, const T& value)
+    {
+        if constexpr (Format == NMEAFieldFormat::Fixed)
+            stream << NMEAInsertionStream::FloatFormat {Precision} << value.*Member
+                   << NMEAInsertionStream::FloatFormat {};
+        else if constexpr (Format == NMEAFieldFormat::Hex)
+            stream << NMEAInsertionStream::Hex() << static_cast<int>(value.*Member) << NMEAInsertionStream::Dec();
+        else
+            stream << value.*Member;
+    }
+
+    template <class T>
+    static void read(NMEAExtractionStream& stream, T& value)
+    {
+        readValue(stream, value.*Member);
+    }
+
+    /// Reads the field into a value of the member's type that lives outside a T.
+    template <class U>
+    static void readValue(NMEAExtractionStream& stream, U& out)
+    {
+        if constexpr (Format == NMEAFieldFormat::Hex)
+        {
+            Register32Bits reg;
+            stream >> reg;
+            out = static_cast<U>(reg.toUInt());
+        }
+        else
+            stream >> out;
+    }
+};
+
+/**
+ * @brief The NMEASchemaDefinition struct is the base of an NMEASchema<T> specialization: the
+ * fields of T in wire order. From that list it generates write() and read(), which
+ * AnyNMEAMessage and the stream operators below use, and works out at compile time how many
+ * fields the sentence has and how long it can get. A schema whose longest sentence exceeds
+ * NMEAMaxSentenceLength does not compile.
+ *
+ * @code
+ * template <>
+ * struct NMEASchema<RMCMessage> : NMEASchemaDefinition<RMCMessage,
+ *     NMEAField<&RMCMessage::i, 11>,
+ *     NMEAField<&RMCMessage::d, 16, NMEAFieldFormat::Fixed, 6>>
+ * {
+ *     static constexpr NMEAMessageName messageName() { return "RMC"; }
+ * };
+ * @endcode
+ */
+template <class T, class... Fields>
+struct NMEASchemaDefinition
+{
+    using Message = T;
+
+    /// Payload fields, not counting the "$TTMMM" header field.
+    static constexpr std::size_t FieldCount = sizeof...(Fields);
+
+    /// "$TTMMM" + ",field" for every field + "*hh\r\n".
+    static constexpr std::size_t MaxSentenceLength = 6 + ((1 + Fields::Width) + ...) + 5;
+
+    /// A buffer that always holds an encoded sentence, and the NUL EndMsg adds when it fits.
+    using Buffer = std::array<char, MaxSentenceLength + 1>;
+
+    static_assert(FieldCount > 0, "An NMEASchema needs at least one field");
+    static_assert(FieldCount + 1 <= NMEAExtractionStream::MaxFields,
+                  "Too many fields for NMEAExtractionStream");
+    static_assert(MaxSentenceLength <= NMEAMaxSentenceLength,
+                  "The longest sentence this schema can produce exceeds the 82 characters NMEA 0183 allows");
+
+    /// Writes every field, then the "*hh\r\n" trailer.
+    static void write(NMEAInsertionStream& stream, const T& value)
+    {
+        (Fields::write(stream, value), ...);
+        stream << NMEAInsertionStream::EndMsg();
+    }
+
+    /// Reads every field in order; the fold unrolls into straight-line code.
+    static void read(NMEAExtractionStream& stream, T& value)
+    {
+        (Fields::read(stream, value), ...);
+    }
+
+    /// @return The wire position of Member's field (1 is the first after the header), or 0
+    /// if the schema has no field for Member.
+    template <auto Member>
+    static constexpr std::size_t fieldIndex()
+    {
+        constexpr bool matches[] = { std::is_same<MemberTag<Member>, MemberTag<Fields::MemberPointer>>::value... };
+        for (std::size_t i = 0; i < FieldCount; ++i)
+            if (matches[i])
+                return i + 1;
+        return 0;
+    }
+
+    /// Reads the next field of stream into out, formatted as Member's field.
+    template <auto Member, class U>
+    static void readField(NMEAExtractionStream& stream, U& out)
+    {
+        static_assert(fieldIndex<Member>() != 0, "Member is not a field of this NMEASchema");
+        (void)(readFieldIf<Member, Fields>(stream, out) || ...);
+    }
+
+private:
+    template <auto Member>
+    struct MemberTag {};
+
+    template <auto Member, class Field, class U>
+    static bool readFieldIf(NMEAExtractionStream& stream, U& out)
+    {
+        if constexpr (std::is_same<MemberTag<Member>, MemberTag<Field::MemberPointer>>::value)
+        {
+            Field::readValue(stream, out);
+            return true;
+        }
+        else
+            return false;
+    }
+};
+
+//
+// The payload hooks AnyNMEAMessage.h declares, generated for every type with an
+// NMEASchema<T> specialization. Types without a schema keep overloading them by hand; a
+// non-template overload always wins over these.
+//
+
+template <class T>
+NMEAInsertionStream& operator<<(NMEAInsertionStream& stream, const T& value)
+{
+    NMEASchema<T>::write(stream, value);
+    return stream;
+}
+
+template <class T>
+NMEAExtractionStream& operator>>(NMEAExtractionStream& stream, T& value)
+{
+    NMEASchema<T>::read(stream, value);
+    return stream;
+}
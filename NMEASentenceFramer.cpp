@@ -0,0 +1,114 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2025 Mark Wilson
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+//  https://www.boost.org/LICENSE_1_0.txt)
+//-----------------------------------------------------------------------------
+#include <algorithm>
+#include <cstring>
+#include <string_view>
+
+#include "NMEACommon.h"
+#include "NMEAExtractionStream.h"
+#include "NMEAScanner.h"
+#include "NMEASentenceFramer.h"
+
+NMEASentenceFramer::NMEASentenceFramer(std::size_t capacity) :
+    mCapacity(std::max(capacity, 2 * NMEAMaxSentenceLength))
+{
+    mBuffer = std::make_unique<char[]>(mCapacity);
+}
+
+std::size_t NMEASentenceFramer::feed(const char *data, std::size_t size)
+{
+    // Move the partial sentence (if any) to the front; at most one sentence worth of bytes
+    if ( mStart > 0 )
+    {
+        std::memmove(mBuffer.get(), mBuffer.get() + mStart, mEnd - mStart);
+        mEnd -= mStart;
+        mStart = 0;
+    }
+
+    std::size_t n = std::min(size, mCapacity - mEnd);
+    std::memcpy(mBuffer.get() + mEnd, data, n);
+    mEnd += n;
+    mCounters.bytesIn += n;
+
+    return n;
+}
+
+void NMEASentenceFramer::drop(std::size_t count, std::uint64_t &reason)
+{
+    mStart += count;
+    mCounters.droppedBytes += count;
+    reason++;
+}
+
+std::optional<ImmutableBuffer> NMEASentenceFramer::next()
+{
+    const char* buffer = mBuffer.get();
+
+    while ( mStart < mEnd )
+    {
+        const char* begin = buffer + mStart;
+        const std::size_t available = mEnd - mStart;
+
+        if ( *begin != '$' )
+        {
+            const void* dollar = std::memchr(begin, '$', available);
+            drop(dollar ? static_cast<const char*>(dollar) - begin : available, mCounters.garbage);
+            continue;
+        }
+
+        const std::size_t window = std::min(available, NMEAMaxSentenceLength);
+        const char* newline = static_cast<const char*>(std::memchr(begin, '\n', window));
+        const std::size_t searched = newline ? static_cast<std::size_t>(newline - begin) : window;
+
+        // Another '$' before the end of this one means the earlier sentence was cut short
+        if ( const void* dollar = std::memchr(begin + 1, '$', searched - 1) )
+        {
+            drop(static_cast<const char*>(dollar) - begin, mCounters.truncated);
+            continue;
+        }
+
+        if ( !newline )
+        {
+            if ( window < NMEAMaxSentenceLength )
+                break; // need more bytes
+
+            drop(window, mCounters.overlong);
+            continue;
+        }
+
+        const std::size_t length = searched + 1;
+        std::uint16_t fields[NMEAExtractionStream::MaxFields + 1];
+        NMEAScanResult scan;
+        scanNMEASentence(std::string_view(begin, length), fields, NMEAExtractionStream::MaxFields, scan);
+
+        if ( !scan.framed || !scan.hasCRLF )
+        {
+            drop(length, mCounters.malformed);
+            continue;
+        }
+
+        if ( !scan.checksumValid )
+        {
+            drop(length, mCounters.badChecksum);
+            continue;
+        }
+
+        mStart += length;
+        mCounters.sentences++;
+        return ImmutableBuffer(begin, length);
+    }
+
+    return std::nullopt;
+}
+
+void NMEASentenceFramer::clear()
+{
+    mCounters.droppedBytes += mEnd - mStart;
+    mStart = 0;
+    mEnd = 0;
+}
@@ -0,0 +1,111 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2025 Mark Wilson
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+//  https://www.boost.org/LICENSE_1_0.txt)
+//-----------------------------------------------------------------------------
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+
+#include "ImmutableBuffer.h"
+
+/**
+ * @brief The NMEASentenceFramer class turns arbitrary read() chunks into complete sentences.
+ *
+ * Bytes are copied once into a fixed buffer. next() hands out ImmutableBuffer views of every
+ * complete "$...*hh\r\n" sentence that is at most NMEAMaxSentenceLength long and has a valid
+ * checksum; nothing else ever leaves the framer. Garbage, truncated, over-long and corrupt
+ * sentences are dropped and counted, and framing resynchronizes on the next '$'.
+ *
+ * A view returned by next() stays valid until the next call to feed().
+ *
+ * @code
+ * NMEASentenceFramer framer;
+ * framer.feed(chunk, n, [](const ImmutableBuffer& sentence) { ... });
+ * @endcode
+ */
+class NMEASentenceFramer
+{
+public:
+    struct Counters
+    {
+        std::uint64_t bytesIn {0};        ///< Bytes accepted by feed()
+        std::uint64_t sentences {0};      ///< Valid sentences returned by next()
+        std::uint64_t droppedBytes {0};   ///< Bytes discarded for any of the reasons below
+        std::uint64_t garbage {0};        ///< Runs of bytes skipped while looking for '$'
+        std::uint64_t truncated {0};      ///< A '$' arrived before the previous sentence's "\n"
+        std::uint64_t overlong {0};       ///< No "\n" within NMEAMaxSentenceLength bytes of '$'
+        std::uint64_t malformed {0};      ///< Ends in "\n" but is not "$...*hh\r\n"
+        std::uint64_t badChecksum {0};    ///< Well formed, checksum mismatch
+    };
+
+    /**
+     * @brief DefaultCapacity holds a few dozen sentences; the minimum is two full sentences.
+     */
+    static constexpr std::size_t DefaultCapacity = 4096;
+
+    explicit NMEASentenceFramer(std::size_t capacity = DefaultCapacity);
+
+    NMEASentenceFramer(const NMEASentenceFramer&) = delete;
+    NMEASentenceFramer& operator=(const NMEASentenceFramer&) = delete;
+
+    /**
+     * @brief feed copies as much of data as fits after compacting the buffer.
+     * Invalidates views returned by next().
+     * @return The number of bytes accepted; less than size only if the buffer is full of
+     * sentences that have not been taken with next() yet.
+     */
+    std::size_t feed(const char* data, std::size_t size);
+
+    /**
+     * @brief feed accepts all of data, calling onSentence(const ImmutableBuffer&) for each
+     * complete valid sentence as soon as it is framed.
+     */
+    template <class F>
+    void feed(const char* data, std::size_t size, F&& onSentence)
+    {
+        while (true)
+        {
+            std::size_t used = feed(data, size);
+            data += used;
+            size -= used;
+
+            while (std::optional<ImmutableBuffer> sentence = next())
+                onSentence(*sentence);
+
+            if (size == 0)
+                break;
+        }
+    }
+
+    /**
+     * @return The next complete valid sentence, or nothing until more bytes are fed.
+     */
+    std::optional<ImmutableBuffer> next();
+
+    /**
+     * @brief clear drops any buffered partial sentence (counted as dropped).
+     */
+    void clear();
+
+    const Counters& counters() const { return mCounters; }
+
+    std::size_t capacity() const { return mCapacity; }
+
+    /// @return Bytes buffered but not yet returned or dropped.
+    std::size_t pending() const { return mEnd - mStart; }
+
+private:
+    std::unique_ptr<char[]> mBuffer;
+    std::size_t mCapacity;
+    std::size_t mStart {0};
+    std::size_t mEnd {0};
+    Counters mCounters;
+
+    void drop(std::size_t count, std::uint64_t& reason);
+};
@@ -0,0 +1,159 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2025 Mark Wilson
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+//  https://www.boost.org/LICENSE_1_0.txt)
+//-----------------------------------------------------------------------------
+#include <algorithm>
+
+#include "NMEAThreadPool.h"
+#include "NMEAExceptions.h"
+
+NMEAThreadPool::NMEAThreadPool(unsigned threads)
+{
+    if ( threads == 0 )
+        threads = std::max(1u, std::thread::hardware_concurrency());
+
+    for (unsigned i = 0; i < threads; ++i)
+        mQueues.push_back(std::make_unique<WorkerQueue>());
+
+    mThreads.reserve(threads - 1);
+    for (unsigned i = 1; i < threads; ++i)
+        mThreads.emplace_back([this, i] { workerLoop(i); });
+}
+
+NMEAThreadPool::~NMEAThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mStateMutex);
+        mStop = true;
+    }
+    mWake.notify_all();
+
+    for (auto& thread : mThreads)
+        thread.join();
+}
+
+void NMEAThreadPool::run(std::size_t count, std::size_t grain, RangeFunction function, void* context)
+{
+    if ( count == 0 )
+        return;
+    grain = std::max<std::size_t>(grain, 1);
+
+    const std::size_t taskCount = (count + grain - 1) / grain;
+
+    // Nothing to share: skip the hand-off entirely
+    if ( size() == 1 || taskCount == 1 )
+    {
+        for (std::size_t begin = 0; begin < count; begin += grain)
+            function(context, begin, std::min(count, begin + grain));
+        return;
+    }
+
+    std::lock_guard<std::mutex> runLock(mRunMutex);
+
+    mFailed.store(false, std::memory_order_relaxed);
+    mError = nullptr;
+    mRemaining.store(taskCount, std::memory_order_relaxed);
+
+    const std::size_t workers = size();
+    for (std::size_t w = 0; w < workers; ++w)
+    {
+        const std::size_t first = taskCount * w / workers;
+        const std::size_t last = taskCount * (w + 1) / workers;
+
+        std::lock_guard<std::mutex> lock(mQueues[w]->mutex);
+        for (std::size_t t = first; t < last; ++t)
+            mQueues[w]->tasks.push_back(Task {function, context, t * grain, std::min(count, (t + 1) * grain)});
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mStateMutex);
+        ++mGeneration;
+    }
+    mWake.notify_all();
+
+    drain(0);
+
+    {
+        std::unique_lock<std::mutex> lock(mStateMutex);
+        mDone.wait(lock, [this] { return mRemaining.load(std::memory_order_acquire) == 0; });
+    }
+
+    if ( mError )
+        std::rethrow_exception(mError);
+}
+
+void NMEAThreadPool::workerLoop(unsigned self)
+{
+    std::uint64_t seen = 0;
+    for (;;)
+    {
+        {
+            std::unique_lock<std::mutex> lock(mStateMutex);
+            mWake.wait(lock, [&] { return mStop || mGeneration != seen; });
+            if ( mStop )
+                return;
+            seen = mGeneration;
+        }
+        drain(self);
+    }
+}
+
+void NMEAThreadPool::drain(unsigned self)
+{
+    Task task {};
+    while ( take(self, task) )
+    {
+        if ( !mFailed.load(std::memory_order_relaxed) )
+        {
+            NMEA_TRY
+            {
+                task.function(task.context, task.begin, task.end);
+            }
+            NMEA_CATCH_ALL
+            {
+                std::lock_guard<std::mutex> lock(mStateMutex);
+                if ( !mError )
+                    mError = std::current_exception();
+                mFailed.store(true, std::memory_order_relaxed);
+            }
+        }
+
+        if ( mRemaining.fetch_sub(1, std::memory_order_acq_rel) == 1 )
+        {
+            std::lock_guard<std::mutex> lock(mStateMutex);
+            mDone.notify_all();
+        }
+    }
+}
+
+bool NMEAThreadPool::take(unsigned self, Task &task)
+{
+    {
+        WorkerQueue& own = *mQueues[self];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if ( !own.tasks.empty() )
+        {
+            task = own.tasks.front();
+            own.tasks.pop_front();
+            return true;
+        }
+    }
+
+    const std::size_t workers = mQueues.size();
+    for (std::size_t i = 1; i < workers; ++i)
+    {
+        WorkerQueue& victim = *mQueues[(self + i) % workers];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if ( !victim.tasks.empty() )
+        {
+            task = victim.tasks.back();
+            victim.tasks.pop_back();
+            return true;
+        }
+    }
+
+    return false;
+}
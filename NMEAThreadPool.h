@@ -0,0 +1,100 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2025 Mark Wilson
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+//  https://www.boost.org/LICENSE_1_0.txt)
+//-----------------------------------------------------------------------------
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+/**
+ * @brief The NMEAThreadPool class runs data-parallel loops on a fixed set of threads.
+ *
+ * parallelFor() cuts [0, count) into grain sized ranges and deals them out in contiguous
+ * blocks, one deque per worker. A worker takes ranges from the front of its own deque and,
+ * once that is empty, steals from the back of the others', so uneven ranges even out without
+ * a shared queue everybody contends on. The calling thread works as worker 0.
+ *
+ * One parallelFor() runs at a time; calling it from inside a body is not supported.
+ */
+class NMEAThreadPool
+{
+public:
+    /// @param threads Total workers including the caller; 0 means hardware_concurrency().
+    explicit NMEAThreadPool(unsigned threads = 0);
+
+    ~NMEAThreadPool();
+
+    NMEAThreadPool(const NMEAThreadPool&) = delete;
+    NMEAThreadPool& operator=(const NMEAThreadPool&) = delete;
+
+    /// @return The number of workers, the calling thread included.
+    unsigned size() const { return static_cast<unsigned>(mQueues.size()); }
+
+    /**
+     * @brief parallelFor calls body(begin, end) for consecutive ranges covering [0, count),
+     * each at most grain long, and returns when all of them are done. The first exception a
+     * body throws is rethrown here; ranges not yet started are then skipped.
+     */
+    template <class F>
+    void parallelFor(std::size_t count, std::size_t grain, F&& body)
+    {
+        using Body = std::remove_reference_t<F>;
+        run(count, grain, [](void* context, std::size_t begin, std::size_t end) {
+            (*static_cast<Body*>(context))(begin, end);
+        }, const_cast<void*>(static_cast<const void*>(&body)));
+    }
+
+private:
+    using RangeFunction = void (*)(void* context, std::size_t begin, std::size_t end);
+
+    struct Task
+    {
+        RangeFunction function;
+        void* context;
+        std::size_t begin;
+        std::size_t end;
+    };
+
+    // Padded so the owner and thieves of neighbouring queues do not share a cache line.
+    struct alignas(64) WorkerQueue
+    {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    std::vector<std::unique_ptr<WorkerQueue>> mQueues;
+    std::vector<std::thread> mThreads;
+
+    std::mutex mRunMutex;
+
+    std::mutex mStateMutex;
+    std::condition_variable mWake;
+    std::condition_variable mDone;
+    std::uint64_t mGeneration {0};
+    bool mStop {false};
+
+    std::atomic<std::size_t> mRemaining {0};
+    std::atomic<bool> mFailed {false};
+    std::exception_ptr mError;
+
+    void run(std::size_t count, std::size_t grain, RangeFunction function, void* context);
+
+    void workerLoop(unsigned self);
+
+    void drain(unsigned self);
+
+    bool take(unsigned self, Task& task);
+};
@@ -0,0 +1,407 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2025 Mark Wilson
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+//  https://www.boost.org/LICENSE_1_0.txt)
+//-----------------------------------------------------------------------------
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <stdexcept>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <typeinfo>
+#include <utility>
+#include <variant>
+
+#include "AnyNMEAMessage.h"
+#include "NMEACommon.h"
+#include "NMEADecodeStats.h"
+#include "NMEAExceptions.h"
+#include "NMEAExtractionStream.h"
+#include "NMEAHeader.h"
+#include "NMEAInsertionStream.h"
+#include "NMEAMessageRegistry.h"
+
+/**
+ * @brief The NMEAVariantMessage class is the closed-set counterpart of AnyNMEAMessage, for
+ * builds that know every message type up front: the payload is one of Messages..., stored
+ * inline in a std::variant, so nothing is ever allocated and no memory resource is involved.
+ *
+ * It offers AnyNMEAMessage's isEmpty/operator bool/type/isType/get/tryGet,
+ * (try)serialize/(try)deserialize and header accessors, so code written against one
+ * compiles against the other. serialize(), deserialize() and visit() go through constexpr
+ * tables of function pointers indexed by the alternative, one indirect call each. decode()
+ * and tryDecode() decode a sentence straight into the variant, looking its name up in
+ * NMEAMessageRegistry<Messages...>, and count outcomes in the decode statistics exactly as
+ * the registry does.
+ *
+ * @code
+ * using GatewayMessage = NMEAVariantMessage<GGAMessage, RMCMessage>;
+ * GatewayMessage m;
+ * if (GatewayMessage::tryDecode(stream, m) == NMEADecodeStatus::Ok)
+ *     m.visit([](const auto& payload) { ... });
+ * AnyNMEAMessage any = m.toAny();       // and back: GatewayMessage(any)
+ * @endcode
+ */
+template <class... Messages>
+class NMEAVariantMessage
+{
+public:
+    using Registry = NMEAMessageRegistry<Messages...>;
+
+    static constexpr std::size_t size() noexcept { return sizeof...(Messages); }
+
+    /// @return One plus T's position in Messages..., or 0 if T is not one of them.
+    template <class T>
+    static constexpr std::size_t indexOf() noexcept
+    {
+        constexpr bool matches[] = {std::is_same<std::decay_t<T>, Messages>::value...};
+        for (std::size_t i = 0; i < sizeof...(Messages); ++i)
+            if (matches[i])
+                return i + 1;
+        return 0;
+    }
+
+    template <class T>
+    static constexpr bool canHold() noexcept { return indexOf<T>() != 0; }
+
+    NMEAVariantMessage() = default;
+
+    // talker + explicit messageName + value
+    template <class T, class = std::enable_if_t<canHold<T>()>>
+    NMEAVariantMessage(std::string_view talker, std::string_view messageName, T value)
+        : header_(talker, NMEAMessageName(messageName))
+        , value_(std::in_place_type<T>, std::move(value))
+    {
+        validateTalkerHeader(talker, messageName);
+    }
+
+    // talker + value, messageName deduced via NMEATraits<T>
+    template <class T, class = std::enable_if_t<canHold<T>()>>
+    NMEAVariantMessage(std::string_view talker, T value)
+        : header_(talker, NMEAMessageName(NMEATraits<T>::messageName()))
+        , value_(std::in_place_type<T>, std::move(value))
+    {
+        validateTalkerHeader(talker, header_.messageName());
+    }
+
+    // already validated header + value
+    template <class T, class = std::enable_if_t<canHold<T>()>>
+    NMEAVariantMessage(const NMEAHeader& header, T value)
+        : header_(header)
+        , value_(std::in_place_type<T>, std::move(value))
+    {
+        validateTalkerHeader(header_.talker(), header_.messageName());
+    }
+
+    /// Copies any's payload if it is one of Messages..., otherwise the result is empty.
+    explicit NMEAVariantMessage(const AnyNMEAMessage& any)
+        : header_(any.getHeader())
+        , checksum_(any.getChecksum())
+        , size_(any.getSize())
+    {
+        if (!(copyFrom<Messages>(any) || ...))
+            clear();
+    }
+
+    /**
+     * @brief toAny copies the message into an AnyNMEAMessage.
+     * @param resource Where the AnyNMEAMessage allocates a payload too large to store inline.
+     */
+    AnyNMEAMessage toAny(std::pmr::memory_resource* resource = std::pmr::get_default_resource()) const
+    {
+        if (isEmpty())
+            return AnyNMEAMessage(resource);
+        return ToAny[value_.index() - 1](value_, header_, resource);
+    }
+
+    bool isEmpty() const noexcept { return value_.index() == 0; }
+
+    /// Same meaning as AnyNMEAMessage's: true when empty.
+    explicit operator bool() const noexcept { return isEmpty(); }
+
+    // Type queries / access
+
+    /**
+     * @brief type is kept for compatibility with AnyNMEAMessage; prefer isType<T>() or
+     * index(). typeid(void) when empty.
+     */
+    const std::type_info& type() const noexcept
+    {
+        static const std::type_info* const Types[] = { &typeid(void), &typeid(Messages)... };
+        return *Types[value_.index()];
+    }
+
+    /// @return One plus the position of the payload's type in Messages..., or 0 when empty.
+    std::size_t index() const noexcept { return value_.index(); }
+
+    template <class T>
+    bool isType() const noexcept
+    {
+        static_assert(canHold<T>(), "T is not one of the NMEAVariantMessage's types");
+        return value_.index() == indexOf<T>();
+    }
+
+    template <class T>
+    T& get()
+    {
+        checkType<T>();
+        return *std::get_if<std::decay_t<T>>(&value_);
+    }
+
+    template <class T>
+    const T& get() const
+    {
+        checkType<T>();
+        return *std::get_if<std::decay_t<T>>(&value_);
+    }
+
+    /// @return The payload if it is a T, otherwise nullptr. Never throws.
+    template <class T>
+    T* tryGet() noexcept
+    {
+        return isType<T>() ? std::get_if<std::decay_t<T>>(&value_) : nullptr;
+    }
+
+    template <class T>
+    const T* tryGet() const noexcept
+    {
+        return isType<T>() ? std::get_if<std::decay_t<T>>(&value_) : nullptr;
+    }
+
+    /// @brief visit calls f with the payload as its real type. The message must not be empty.
+    template <class F>
+    decltype(auto) visit(F&& f) const
+    {
+        using Result = decltype(f(std::declval<const First&>()));
+        using Function = Result (*)(const Variant&, F&);
+        static constexpr Function Visitors[] = {&visitAs<Messages, Result, F>...};
+        if (isEmpty()) NMEA_THROW(std::runtime_error("Empty NMEAVariantMessage"));
+        return Visitors[value_.index() - 1](value_, f);
+    }
+
+    // Serialization / deserialization — payload only, as for AnyNMEAMessage
+    void serialize(NMEAInsertionStream& ns) const
+    {
+        if (isEmpty()) NMEA_THROW(std::runtime_error("Empty NMEAVariantMessage"));
+        Writers[value_.index() - 1](value_, ns);
+    }
+
+    void deserialize(NMEAExtractionStream& ex)
+    {
+        if (isEmpty()) NMEA_THROW(std::runtime_error("Empty NMEAVariantMessage"));
+        Readers[value_.index() - 1](value_, ex);
+    }
+
+    /// @return false, writing nothing, if the message is empty.
+    bool trySerialize(NMEAInsertionStream& ns) const
+    {
+        if (isEmpty())
+            return false;
+        Writers[value_.index() - 1](value_, ns);
+        return true;
+    }
+
+    /// @return false, reading nothing, if the message is empty.
+    bool tryDeserialize(NMEAExtractionStream& ex)
+    {
+        if (isEmpty())
+            return false;
+        Readers[value_.index() - 1](value_, ex);
+        return true;
+    }
+
+    /**
+     * @brief decode is NMEAMessageRegistry<Messages...>::decode(stream, status) decoding into
+     * an NMEAVariantMessage: it rejects unframed sentences, bad checksums, malformed headers
+     * and unknown names, and says why nothing was decoded. Exceptions thrown by the message
+     * type's extraction operator propagate.
+     * @param status Ok if the returned message is non-empty.
+     */
+    static NMEAVariantMessage decode(NMEAExtractionStream& stream, NMEADecodeStatus& status)
+    {
+        NMEAVariantMessage message;
+        status = decodeInto(stream, message);
+        return message;
+    }
+
+    /**
+     * @brief tryDecode is decode() for code that cannot take exceptions; an extraction
+     * operator that throws is reported as DecodeFailed.
+     * @param message Receives the decoded payload; left empty unless Ok is returned.
+     */
+    static NMEADecodeStatus tryDecode(NMEAExtractionStream& stream, NMEAVariantMessage& message) noexcept
+    {
+        NMEA_TRY
+        {
+            return decodeInto(stream, message);
+        }
+        NMEA_CATCH_ALL
+        {
+            message.clear();
+        }
+        return NMEADecodeStatus::DecodeFailed;
+    }
+
+    // Read-only metadata, as for AnyNMEAMessage
+    std::string_view   getTalker()      const noexcept { return header_.talker(); }
+    std::string_view   getMessageName() const noexcept { return header_.messageName(); }
+    const NMEAHeader&  getHeader()      const noexcept { return header_; }
+    std::uint8_t       getChecksum()    const noexcept { return checksum_; }
+    std::size_t        getSize()        const noexcept { return size_; }
+
+private:
+    static_assert(sizeof...(Messages) > 0, "NMEAVariantMessage needs at least one message type");
+
+    using Variant = std::variant<std::monostate, Messages...>;
+    using First = std::tuple_element_t<0, std::tuple<Messages...>>;
+
+    template <class T>
+    static constexpr bool isUnique() noexcept
+    {
+        return (std::size_t {0} + ... + std::size_t {std::is_same<T, Messages>::value}) == 1;
+    }
+
+    static_assert((isUnique<Messages>() && ...), "NMEAVariantMessage lists a message type twice");
+
+    // One entry per alternative, indexed by value_.index() - 1
+
+    template <class T>
+    static void writeAs(const Variant& v, NMEAInsertionStream& ns)
+    {
+        using ::operator<<; ns << *std::get_if<T>(&v);
+    }
+
+    template <class T>
+    static void readAs(Variant& v, NMEAExtractionStream& ex)
+    {
+        using ::operator>>; ex >> *std::get_if<T>(&v);
+    }
+
+    // Replaces v with a value initialized T and reads it from ex
+    template <class T>
+    static void emplaceAs(Variant& v, NMEAExtractionStream& ex)
+    {
+        T& value = v.template emplace<T>();
+        using ::operator>>; ex >> value;
+    }
+
+    template <class T>
+    static AnyNMEAMessage toAnyAs(const Variant& v, const NMEAHeader& header, std::pmr::memory_resource* resource)
+    {
+        return AnyNMEAMessage(header, *std::get_if<T>(&v), resource);
+    }
+
+    template <class T, class Result, class F>
+    static Result visitAs(const Variant& v, F& f)
+    {
+        return f(*std::get_if<T>(&v));
+    }
+
+    static constexpr std::array<void (*)(const Variant&, NMEAInsertionStream&), sizeof...(Messages)> Writers {
+        &writeAs<Messages>...
+    };
+
+    static constexpr std::array<void (*)(Variant&, NMEAExtractionStream&), sizeof...(Messages)> Readers {
+        &readAs<Messages>...
+    };
+
+    static constexpr std::array<void (*)(Variant&, NMEAExtractionStream&), sizeof...(Messages)> Emplacers {
+        &emplaceAs<Messages>...
+    };
+
+    static constexpr std::array<AnyNMEAMessage (*)(const Variant&, const NMEAHeader&, std::pmr::memory_resource*),
+                                sizeof...(Messages)> ToAny {
+        &toAnyAs<Messages>...
+    };
+
+    template <class T>
+    bool copyFrom(const AnyNMEAMessage& any)
+    {
+        const T* payload = any.tryGet<T>();
+        if (payload)
+            value_.template emplace<T>(*payload);
+        return payload != nullptr;
+    }
+
+    static NMEADecodeStatus decodeInto(NMEAExtractionStream& stream, NMEAVariantMessage& message)
+    {
+        message.clear();
+
+        const NMEAHeader header = stream.getHeader();
+
+        // First: on a lazy stream this finishes the scan, which may yet find the sentence
+        // unframed
+        const bool checksumValid = stream.isChecksumValid();
+        if (!stream.isFramed())
+            return NMEADecodeStatus::BadFraming; // already counted by the stream
+
+        NMEADecodeStatus status;
+        std::size_t index = Registry::size();
+        if (!checksumValid)
+            status = NMEADecodeStatus::BadChecksum;
+        else if (!header.isValid())
+            status = NMEADecodeStatus::BadHeader;
+        else if ((index = Registry::indexOf(header.name())) != Registry::size())
+        {
+            NMEA_TRY
+            {
+                NMEALatencyScope latency(NMEALatencyStage::Decode);
+                Emplacers[index](message.value_, stream);
+                if (!stream.good())
+                {
+                    // A field did not parse: no partial payloads, as for the registry
+                    message.clear();
+                    recordNMEADecode(NMEADecodeStatus::DecodeFailed, header.name());
+                    return NMEADecodeStatus::DecodeFailed;
+                }
+                message.header_ = header;
+                recordNMEADecode(NMEADecodeStatus::Ok, header.name());
+            }
+            NMEA_CATCH_ALL
+            {
+                message.clear();
+                recordNMEADecode(NMEADecodeStatus::DecodeFailed, header.name());
+                NMEA_RETHROW;
+            }
+            return NMEADecodeStatus::Ok;
+        }
+        else
+            status = NMEADecodeStatus::UnknownType;
+
+        recordNMEADecode(status, status == NMEADecodeStatus::UnknownType ? header.name() : NMEAMessageName());
+        return status;
+    }
+
+    void clear() noexcept
+    {
+        value_.template emplace<0>();
+        header_ = NMEAHeader();
+        checksum_ = 0;
+        size_ = 0;
+    }
+
+    template <class T>
+    void checkType() const
+    {
+        if (!isType<T>()) NMEA_THROW(std::bad_cast());
+    }
+
+    void validateTalkerHeader(std::string_view talker, std::string_view messageName) const
+    {
+        if (talker.size() != 2 || !header_.isTalkerValid()) NMEA_THROW(std::runtime_error("talker must be 2 chars"));
+        if (messageName.size() != 3 || !header_.isNameValid()) NMEA_THROW(std::runtime_error("messageName must be 3 chars"));
+    }
+
+private:
+    NMEAHeader header_;
+    std::uint8_t checksum_ = 0;
+    std::size_t  size_     = 0;
+    Variant value_;
+};
@@ -0,0 +1,18 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2025 Mark Wilson
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+//  https://www.boost.org/LICENSE_1_0.txt)
+//-----------------------------------------------------------------------------
+#pragma once
+
+#include <cstddef>
+
+//
+// Linking AllocationCounter.cpp into a benchmark replaces the global operator new/delete
+// with versions that count every allocation made by the process.
+//
+
+/// @return The number of successful global operator new calls so far.
+std::size_t allocationCount();
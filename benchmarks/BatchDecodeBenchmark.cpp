@@ -0,0 +1,93 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2025 Mark Wilson
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+//  https://www.boost.org/LICENSE_1_0.txt)
+//-----------------------------------------------------------------------------
+//
+// decodeNMEABatch scaling: one-by-one decode on the calling thread, then the batch API at
+// 1, 2, 4 ... maxThreads workers, then a grain size sweep at maxThreads.
+//
+// Usage: BatchDecodeBenchmark [maxThreads] [sentences]
+//
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "ExampleMessages.h"
+#include "NMEABatchDecoder.h"
+#include "NMEAMessageRegistry.h"
+#include "NMEAThreadPool.h"
+
+#include "BenchmarkHarness.h"
+#include "NMEACorpusGenerator.h"
+
+namespace {
+
+using Registry = NMEAMessageRegistry<GGAMessage, RMCMessage>;
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const unsigned maxThreads = argc > 1 ? static_cast<unsigned>(std::strtoul(argv[1], nullptr, 10)) : 64;
+    const std::size_t count = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 200000;
+
+    std::vector<std::string> storage;
+    storage.reserve(count);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        storage.push_back(i % 2 == 0
+            ? makeNMEASentence("GPGGA," + std::to_string(i % 1000) + "," + std::to_string(i % 977) + ".125,FIX")
+            : makeNMEASentence("GPRMC," + std::to_string(i % 512) + "," + std::to_string(i % 89) + ".5"));
+        if (i % 97 == 0)
+            storage.back()[3] ^= 1;  // a sprinkling of checksum failures
+    }
+
+    std::vector<ImmutableBuffer> input;
+    input.reserve(count);
+    for (const auto& s : storage)
+        input.emplace_back(s.data(), s.size());
+
+    std::vector<AnyNMEAMessage> output(count);
+    std::vector<NMEADecodeStatus> status(count);
+
+    std::printf("%zu sentences, %u hardware threads\n", count, std::thread::hardware_concurrency());
+
+    runBenchmark("one by one, Registry::decode", 5, [&] {
+        for (std::size_t i = 0; i < count; ++i)
+            output[i] = Registry::decode(input[i]);
+        doNotOptimize(output.data());
+    }, count);
+
+    runBenchmark("decodeNMEABatch, no pool", 5, [&] {
+        doNotOptimize(decodeNMEABatch<Registry>(input.data(), count, output.data(), status.data()));
+    }, count);
+
+    for (unsigned threads = 1; threads <= maxThreads; threads *= 2)
+    {
+        NMEAThreadPool pool(threads);
+        NMEABatchOptions options;
+        options.pool = &pool;
+
+        runBenchmark("decodeNMEABatch, " + std::to_string(threads) + " thread(s)", 5, [&] {
+            doNotOptimize(decodeNMEABatch<Registry>(input.data(), count, output.data(), status.data(), options));
+        }, count);
+    }
+
+    NMEAThreadPool pool(maxThreads);
+    for (std::size_t grain : {16u, 64u, 256u, 1024u, 4096u})
+    {
+        NMEABatchOptions options;
+        options.pool = &pool;
+        options.grainSize = grain;
+
+        runBenchmark("grain " + std::to_string(grain) + ", " + std::to_string(maxThreads) + " threads", 5, [&] {
+            doNotOptimize(decodeNMEABatch<Registry>(input.data(), count, output.data(), status.data(), options));
+        }, count);
+    }
+
+    return 0;
+}
@@ -0,0 +1,75 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2025 Mark Wilson
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+//  https://www.boost.org/LICENSE_1_0.txt)
+//-----------------------------------------------------------------------------
+//
+// A burst of 200 sentences: one buffer and one stream per message against
+// NMEABatchEncoder packing them into a single buffer, and the same burst through a
+// buffer too small to hold it, flushed and resumed.
+//
+#include <array>
+#include <cstdio>
+#include <vector>
+
+#include "AnyNMEAMessage.h"
+#include "ExampleMessages.h"
+#include "MutableBuffer.h"
+#include "NMEABatchEncoder.h"
+#include "NMEACommon.h"
+#include "NMEAInsertionStream.h"
+
+#include "BenchmarkHarness.h"
+
+int main()
+{
+    constexpr std::size_t Burst = 200;
+    constexpr std::size_t Iterations = 20000;
+
+    std::vector<AnyNMEAMessage> messages;
+    messages.reserve(Burst);
+    for (std::size_t i = 0; i < Burst; ++i)
+    {
+        if (i % 2 == 0)
+            messages.emplace_back("GP", GGAMessage {static_cast<int>(i), i * 0.25, "FIX"});
+        else
+            messages.emplace_back("GP", RMCMessage {i * 1.5, static_cast<int>(i)});
+    }
+
+    std::vector<std::array<char, NMEAMaxSentenceLength + 1>> perMessage(Burst);
+    runBenchmark("per message: own buffer + stream", Iterations, [&] {
+        for (std::size_t i = 0; i < Burst; ++i)
+        {
+            MutableBuffer mb = buffer(perMessage[i]);
+            NMEAInsertionStream stream(mb, messages[i].getHeader());
+            messages[i].serialize(stream);
+            doNotOptimize(stream.size());
+        }
+    }, Burst);
+
+    std::vector<char> storage(Burst * NMEAMaxSentenceLength);
+    NMEABatchEncoder encoder(buffer(storage.data(), storage.size()));
+    runBenchmark("batch: one buffer, offset table", Iterations, [&] {
+        encoder.clear();
+        doNotOptimize(encoder.encode(messages.data(), messages.size()));
+        doNotOptimize(encoder.size());
+    }, Burst);
+    std::printf("  %zu sentences, %zu bytes in one buffer\n", encoder.sentences().size(), encoder.size());
+
+    std::array<char, 1024> small;
+    NMEABatchEncoder smallEncoder(buffer(small));
+    std::size_t flushes = 0;
+    runBenchmark("batch: 1 KiB buffer, flush and resume", Iterations, [&] {
+        for (std::size_t done = 0; done < messages.size(); ++flushes)
+        {
+            smallEncoder.clear();
+            done += smallEncoder.encode(messages.data() + done, messages.size() - done);
+            doNotOptimize(smallEncoder.data());
+        }
+    }, Burst);
+    std::printf("  %.1f flushes per burst\n", static_cast<double>(flushes) / (Iterations + Iterations / 10 + 1));
+
+    return 0;
+}
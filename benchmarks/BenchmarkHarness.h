@@ -0,0 +1,67 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2025 Mark Wilson
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+//  https://www.boost.org/LICENSE_1_0.txt)
+//-----------------------------------------------------------------------------
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <string>
+
+//
+// Minimal, dependency free timing helpers shared by the benchmark executables.
+//
+
+/**
+ * @brief doNotOptimize keeps the compiler from discarding a value computed in a benchmark loop.
+ */
+template <class T>
+inline void doNotOptimize(const T& value)
+{
+#if defined(__GNUC__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const void* sink;
+    sink = &value;
+#endif
+}
+
+struct BenchmarkResult
+{
+    std::string name;
+    std::size_t operations {0};
+    double nsPerOp {0.0};
+
+    double opsPerSecond() const { return nsPerOp > 0.0 ? 1e9 / nsPerOp : 0.0; }
+};
+
+/**
+ * @brief runBenchmark times iterations calls of body() after a short warm-up and prints ns/op.
+ * @param opsPerIteration How many logical operations one call of body() performs.
+ */
+template <class F>
+BenchmarkResult runBenchmark(const std::string& name, std::size_t iterations, F&& body,
+                             std::size_t opsPerIteration = 1)
+{
+    using Clock = std::chrono::steady_clock;
+
+    for (std::size_t i = 0; i < iterations / 10 + 1; ++i)
+        body();
+
+    auto start = Clock::now();
+    for (std::size_t i = 0; i < iterations; ++i)
+        body();
+    auto elapsed = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+
+    BenchmarkResult result;
+    result.name = name;
+    result.operations = iterations * opsPerIteration;
+    result.nsPerOp = elapsed / static_cast<double>(result.operations);
+
+    std::printf("%-48s %12.2f ns/op %14.0f ops/s\n", name.c_str(), result.nsPerOp, result.opsPerSecond());
+    return result;
+}
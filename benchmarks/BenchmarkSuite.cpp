@@ -0,0 +1,301 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2025 Mark Wilson
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+//  https://www.boost.org/LICENSE_1_0.txt)
+//-----------------------------------------------------------------------------
+//
+// The regression suite: every hot path measured over one generated corpus, reported as
+// JSON (ns/op, sentences/s, bytes/s, allocations/op per stage) for tracking between
+// releases. A human readable table goes to stderr.
+//
+// Usage: BenchmarkSuite [--seed=N] [--sentences=N] [--mix=GGA,RMC,UNKNOWN]
+//                      [--text-width=N] [--decimals=N] [--corruption=RATE]
+//                      [--iterations=N] [--json=FILE]
+//
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "AnyNMEAMessage.h"
+#include "ExampleMessages.h"
+#include "MutableBuffer.h"
+#include "NMEACommon.h"
+#include "NMEAExtractionStream.h"
+#include "NMEAInsertionStream.h"
+#include "NMEAMessageRegistry.h"
+#include "NMEAScanner.h"
+
+#include "AllocationCounter.h"
+#include "BenchmarkHarness.h"
+#include "NMEACorpusGenerator.h"
+
+namespace {
+
+using Registry = NMEAMessageRegistry<GGAMessage, RMCMessage>;
+
+struct SuiteOptions
+{
+    NMEACorpusOptions corpus;
+    std::size_t iterations {5};
+    std::string jsonPath;
+};
+
+struct StageResult
+{
+    std::string name;
+    std::size_t operations {0};
+    double nsPerOp {0.0};
+    double sentencesPerSecond {0.0};
+    double bytesPerSecond {0.0};
+    double allocationsPerOp {0.0};
+};
+
+bool parseOption(const char* arg, const char* name, std::string& value)
+{
+    const std::size_t length = std::strlen(name);
+    if (std::strncmp(arg, name, length) != 0 || arg[length] != '=')
+        return false;
+    value = arg + length + 1;
+    return true;
+}
+
+bool parseArguments(int argc, char** argv, SuiteOptions& options)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string value;
+        if (parseOption(argv[i], "--seed", value))
+            options.corpus.seed = std::strtoull(value.c_str(), nullptr, 10);
+        else if (parseOption(argv[i], "--sentences", value))
+            options.corpus.sentences = std::strtoull(value.c_str(), nullptr, 10);
+        else if (parseOption(argv[i], "--mix", value))
+        {
+            unsigned gga = 0, rmc = 0, unknown = 0;
+            if (std::sscanf(value.c_str(), "%u,%u,%u", &gga, &rmc, &unknown) != 3)
+                return false;
+            options.corpus.ggaWeight = gga;
+            options.corpus.rmcWeight = rmc;
+            options.corpus.unknownWeight = unknown;
+        }
+        else if (parseOption(argv[i], "--text-width", value))
+            options.corpus.textWidth = std::strtoull(value.c_str(), nullptr, 10);
+        else if (parseOption(argv[i], "--decimals", value))
+            options.corpus.decimals = std::atoi(value.c_str());
+        else if (parseOption(argv[i], "--corruption", value))
+            options.corpus.corruptionRate = std::strtod(value.c_str(), nullptr);
+        else if (parseOption(argv[i], "--iterations", value))
+            options.iterations = std::max<std::size_t>(1, std::strtoull(value.c_str(), nullptr, 10));
+        else if (parseOption(argv[i], "--json", value))
+            options.jsonPath = value;
+        else
+            return false;
+    }
+    return true;
+}
+
+/**
+ * Runs pass() once to warm up, then iterations times under the clock and the allocation
+ * counter. One pass performs operations operations covering bytes bytes of sentences.
+ */
+template <class F>
+StageResult measureStage(const char* name, std::size_t iterations, std::size_t operations,
+                         std::size_t bytes, F&& pass)
+{
+    using Clock = std::chrono::steady_clock;
+
+    pass();
+
+    const std::size_t allocationsBefore = allocationCount();
+    const auto start = Clock::now();
+    for (std::size_t i = 0; i < iterations; ++i)
+        pass();
+    const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    const std::size_t allocations = allocationCount() - allocationsBefore;
+
+    StageResult result;
+    result.name = name;
+    result.operations = operations * iterations;
+    if (result.operations > 0 && seconds > 0.0)
+    {
+        result.nsPerOp = seconds * 1e9 / static_cast<double>(result.operations);
+        result.sentencesPerSecond = static_cast<double>(result.operations) / seconds;
+        result.bytesPerSecond = static_cast<double>(bytes * iterations) / seconds;
+        result.allocationsPerOp = static_cast<double>(allocations) / static_cast<double>(result.operations);
+    }
+
+    std::fprintf(stderr, "%-24s %10.2f ns/op %14.0f sentences/s %10.1f MB/s %8.3f allocs/op\n",
+                 name, result.nsPerOp, result.sentencesPerSecond, result.bytesPerSecond / 1e6,
+                 result.allocationsPerOp);
+    return result;
+}
+
+void writeJson(std::FILE* out, const SuiteOptions& options, const NMEACorpus& corpus,
+               const std::vector<StageResult>& results)
+{
+    const NMEACorpusOptions& c = options.corpus;
+    std::fprintf(out, "{\n");
+    std::fprintf(out, "  \"suite\": \"BenchmarkSuite\",\n");
+    std::fprintf(out, "  \"iterations\": %zu,\n", options.iterations);
+    std::fprintf(out, "  \"corpus\": {\n");
+    std::fprintf(out, "    \"seed\": %llu,\n", static_cast<unsigned long long>(c.seed));
+    std::fprintf(out, "    \"sentences\": %zu,\n", corpus.sentences.size());
+    std::fprintf(out, "    \"bytes\": %zu,\n", corpus.text.size());
+    std::fprintf(out, "    \"mix\": {\"GGA\": %u, \"RMC\": %u, \"unknown\": %u},\n",
+                 c.ggaWeight, c.rmcWeight, c.unknownWeight);
+    std::fprintf(out, "    \"textWidth\": %zu,\n", c.textWidth);
+    std::fprintf(out, "    \"decimals\": %d,\n", c.decimals);
+    std::fprintf(out, "    \"corruptionRate\": %.6f,\n", c.corruptionRate);
+    std::fprintf(out, "    \"corrupted\": %zu\n", corpus.corrupted);
+    std::fprintf(out, "  },\n");
+    std::fprintf(out, "  \"stages\": [\n");
+    for (std::size_t i = 0; i < results.size(); ++i)
+    {
+        const StageResult& r = results[i];
+        std::fprintf(out,
+                     "    {\"name\": \"%s\", \"operations\": %zu, \"nsPerOp\": %.3f, "
+                     "\"sentencesPerSecond\": %.1f, \"bytesPerSecond\": %.1f, \"allocationsPerOp\": %.4f}%s\n",
+                     r.name.c_str(), r.operations, r.nsPerOp, r.sentencesPerSecond, r.bytesPerSecond,
+                     r.allocationsPerOp, i + 1 < results.size() ? "," : "");
+    }
+    std::fprintf(out, "  ]\n}\n");
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    SuiteOptions options;
+    if (!parseArguments(argc, argv, options))
+    {
+        std::fprintf(stderr, "usage: %s [--seed=N] [--sentences=N] [--mix=GGA,RMC,UNKNOWN] [--text-width=N]\n"
+                             "       [--decimals=N] [--corruption=RATE] [--iterations=N] [--json=FILE]\n", argv[0]);
+        return 2;
+    }
+
+    const NMEACorpus corpus = generateNMEACorpus(options.corpus);
+    const std::size_t count = corpus.sentences.size();
+    const std::size_t corpusBytes = corpus.text.size();
+    const std::size_t iterations = options.iterations;
+
+    std::fprintf(stderr, "corpus: %zu sentences (%zu GGA, %zu RMC, %zu unknown, %zu corrupted), %zu bytes\n",
+                 count, corpus.gga, corpus.rmc, corpus.unknown, corpus.corrupted, corpusBytes);
+
+    std::vector<StageResult> results;
+
+    // Framing: field table, '*' and checksum in one pass
+    results.push_back(measureStage("scan", iterations, count, corpusBytes, [&] {
+        std::array<std::uint16_t, NMEAExtractionStream::MaxFields + 1> fieldStart;
+        for (const auto& s : corpus.sentences)
+        {
+            NMEAScanResult scan;
+            scanNMEASentence(std::string_view(s.data(), s.size()), fieldStart.data(),
+                             NMEAExtractionStream::MaxFields, scan);
+            doNotOptimize(scan);
+        }
+    }));
+
+    results.push_back(measureStage("checksum", iterations, count, corpusBytes, [&] {
+        std::size_t valid = 0;
+        for (const auto& s : corpus.sentences)
+            valid += validateNMEAMessage(s);
+        doNotOptimize(valid);
+    }));
+
+    // Decode everything once outside the clock; later stages work on these messages
+    std::vector<AnyNMEAMessage> messages(count);
+    std::vector<std::size_t> messageBytes;
+    {
+        NMEAExtractionStream stream;
+        std::size_t kept = 0;
+        for (const auto& s : corpus.sentences)
+        {
+            stream.rebind(s);
+            NMEADecodeStatus status;
+            AnyNMEAMessage m = Registry::decode(stream, status);
+            if (status == NMEADecodeStatus::Ok)
+            {
+                messages[kept++] = std::move(m);
+                messageBytes.push_back(s.size());
+            }
+        }
+        messages.resize(kept);
+    }
+    const std::size_t decodedCount = messages.size();
+    std::size_t decodedBytes = 0;
+    for (std::size_t b : messageBytes)
+        decodedBytes += b;
+
+    std::vector<AnyNMEAMessage> decoded(count);
+    results.push_back(measureStage("decode", iterations, count, corpusBytes, [&] {
+        NMEAExtractionStream stream;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            stream.rebind(corpus.sentences[i]);
+            NMEADecodeStatus status;
+            decoded[i] = Registry::decode(stream, status);
+        }
+        doNotOptimize(decoded.data());
+    }));
+    decoded.clear();
+
+    results.push_back(measureStage("encode", iterations, decodedCount, decodedBytes, [&] {
+        std::array<char, NMEAMaxSentenceLength + 1> storage;
+        MutableBuffer mb(storage.data(), storage.size());
+        for (const auto& m : messages)
+        {
+            NMEAInsertionStream stream(mb, m.getHeader());
+            m.serialize(stream);
+            doNotOptimize(stream.size());
+        }
+    }));
+
+    std::vector<AnyNMEAMessage> copies(decodedCount);
+    results.push_back(measureStage("copy", iterations, decodedCount, decodedBytes, [&] {
+        for (std::size_t i = 0; i < decodedCount; ++i)
+            copies[i] = messages[i];
+        doNotOptimize(copies.data());
+    }));
+
+    results.push_back(measureStage("move", iterations, decodedCount, decodedBytes, [&] {
+        for (std::size_t i = 0; i < decodedCount; ++i)
+        {
+            AnyNMEAMessage moved(std::move(copies[i]));
+            copies[i] = std::move(moved);
+        }
+        doNotOptimize(copies.data());
+    }));
+
+    results.push_back(measureStage("get", iterations, decodedCount, decodedBytes, [&] {
+        double sum = 0.0;
+        for (const auto& m : messages)
+        {
+            if (m.isType<GGAMessage>())
+                sum += m.get<GGAMessage>().d;
+            else if (m.isType<RMCMessage>())
+                sum += m.get<RMCMessage>().d;
+        }
+        doNotOptimize(sum);
+    }));
+
+    if (options.jsonPath.empty())
+        writeJson(stdout, options, corpus, results);
+    else
+    {
+        std::FILE* out = std::fopen(options.jsonPath.c_str(), "w");
+        if (!out)
+        {
+            std::perror(options.jsonPath.c_str());
+            return 1;
+        }
+        writeJson(out, options, corpus, results);
+        std::fclose(out);
+    }
+
+    return 0;
+}
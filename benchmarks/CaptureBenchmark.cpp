@@ -0,0 +1,134 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2025 Mark Wilson
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+//  https://www.boost.org/LICENSE_1_0.txt)
+//-----------------------------------------------------------------------------
+//
+// Capture replay throughput: ifstream/getline into ImmutableBuffer against the mmap
+// NMEACaptureDecoder at 1..N threads, ordered and unordered. The capture is generated
+// into a temporary file first and read once so the timed passes hit the page cache.
+//
+// Usage: CaptureBenchmark [MiB] [maxThreads]
+//
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <unistd.h>
+
+#include "ExampleMessages.h"
+#include "NMEACaptureDecoder.h"
+#include "NMEACaptureFile.h"
+#include "NMEAMessageRegistry.h"
+
+#include "BenchmarkHarness.h"
+#include "NMEACorpusGenerator.h"
+
+namespace {
+
+using Registry = NMEAMessageRegistry<GGAMessage, RMCMessage>;
+
+std::size_t writeCapture(const std::string& path, std::size_t bytes)
+{
+    std::ofstream out(path, std::ios::binary);
+    std::size_t written = 0;
+    std::size_t sentences = 0;
+    for (unsigned i = 0; written < bytes; ++i)
+    {
+        std::string s = (i % 2 == 0)
+            ? makeNMEASentence("GPGGA," + std::to_string(i % 1000) + "," + std::to_string(i % 977) + ".125,FIX" + std::to_string(i % 10))
+            : makeNMEASentence("GPRMC," + std::to_string(i % 512) + "," + std::to_string(i % 89) + ".5");
+        out << s;
+        written += s.size();
+        ++sentences;
+    }
+    return sentences;
+}
+
+template <class F>
+void report(const char* name, std::size_t bytes, std::size_t sentences, F&& pass)
+{
+    using Clock = std::chrono::steady_clock;
+
+    pass();  // warm-up
+    constexpr int Repeats = 3;
+    double best = 1e300;
+    for (int r = 0; r < Repeats; ++r)
+    {
+        auto start = Clock::now();
+        pass();
+        best = std::min(best, std::chrono::duration<double>(Clock::now() - start).count());
+    }
+
+    std::printf("%-40s %8.3f GB/s %14.0f sentences/s\n", name, bytes / best / 1e9, sentences / best);
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const std::size_t mib = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 64;
+    const unsigned hw = std::max(1u, std::thread::hardware_concurrency());
+    const unsigned maxThreads = argc > 2 ? static_cast<unsigned>(std::strtoul(argv[2], nullptr, 10)) : hw;
+
+    char path[] = "/tmp/nmea-captureXXXXXX";
+    int fd = ::mkstemp(path);
+    if (fd < 0)
+    {
+        std::perror("mkstemp");
+        return 1;
+    }
+    ::close(fd);
+
+    const std::size_t sentences = writeCapture(path, mib << 20);
+    NMEACaptureFile file(path);
+    std::printf("capture: %zu bytes, %zu sentences, %u hardware threads\n", file.size(), sentences, hw);
+
+    report("ifstream/getline + Registry::decode", file.size(), sentences, [&] {
+        std::ifstream in(path, std::ios::binary);
+        std::string line;
+        std::size_t decoded = 0;
+        while (std::getline(in, line))
+        {
+            if (!line.empty() && line.back() == '\r')
+                line.pop_back();
+            AnyNMEAMessage m = Registry::decode(ImmutableBuffer(line.data(), line.size()));
+            decoded += !m.isEmpty();
+        }
+        doNotOptimize(decoded);
+    });
+
+    for (unsigned threads = 1; threads <= maxThreads; threads *= 2)
+    {
+        NMEACaptureDecoder<Registry> decoder(threads);
+
+        std::string name = "mmap ordered, " + std::to_string(threads) + " thread(s)";
+        report(name.c_str(), file.size(), sentences, [&] {
+            doNotOptimize(decoder.decodeOrdered(file).size());
+        });
+
+        name = "mmap unordered, " + std::to_string(threads) + " thread(s)";
+        report(name.c_str(), file.size(), sentences, [&] {
+            std::atomic<std::size_t> decoded {0};
+            decoder.decodeUnordered(file, [&decoded](AnyNMEAMessage&& m) {
+                doNotOptimize(m);
+                decoded.fetch_add(1, std::memory_order_relaxed);
+            });
+            doNotOptimize(decoded.load());
+        });
+
+        if (decoder.stats().decoded != sentences)
+            std::printf("  unexpected: decoded %zu of %zu\n", decoder.stats().decoded, sentences);
+    }
+
+    ::unlink(path);
+    return 0;
+}
@@ -0,0 +1,110 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2025 Mark Wilson
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+//  https://www.boost.org/LICENSE_1_0.txt)
+//-----------------------------------------------------------------------------
+//
+// Decoding a batch of GGA sentences into std::vector<AnyNMEAMessage> against an
+// NMEAColumnStore, then scanning one field (sum of every d) out of each.
+//
+// Usage: ColumnStoreBenchmark [sentences]
+//
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "AnyNMEAMessage.h"
+#include "ExampleMessages.h"
+#include "NMEAColumnStore.h"
+#include "NMEAExtractionStream.h"
+#include "NMEAMessageRegistry.h"
+
+#include "BenchmarkHarness.h"
+#include "NMEACorpusGenerator.h"
+
+namespace {
+
+using Registry = NMEAMessageRegistry<GGAMessage, RMCMessage>;
+using GGAStore = NMEAColumnStore<GGAMessage, &GGAMessage::i, &GGAMessage::d, &GGAMessage::s>;
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const std::size_t count = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1000000;
+
+    std::vector<std::string> sentences;
+    sentences.reserve(count);
+    for (std::size_t i = 0; i < count; ++i)
+        sentences.push_back(makeNMEASentence("GPGGA," + std::to_string(i % 1000) + "," +
+                                         std::to_string(i % 977) + ".125,FIX"));
+
+    std::printf("%zu GGA sentences, sizeof(AnyNMEAMessage) = %zu\n", count, sizeof(AnyNMEAMessage));
+
+    std::vector<AnyNMEAMessage> messages;
+    messages.reserve(count);
+    runBenchmark("decode into vector<AnyNMEAMessage>", 3, [&] {
+        messages.clear();
+        NMEAExtractionStream stream;
+        for (const auto& s : sentences)
+        {
+            stream.rebind(ImmutableBuffer(s.data(), s.size()));
+            messages.push_back(Registry::decode(stream));
+        }
+    }, count);
+
+    GGAStore store;
+    store.reserve(count);
+    runBenchmark("decode into NMEAColumnStore", 3, [&] {
+        store.clear();
+        NMEAExtractionStream stream;
+        for (const auto& s : sentences)
+        {
+            stream.rebind(ImmutableBuffer(s.data(), s.size()));
+            store.append(stream);
+        }
+    }, count);
+
+    double vectorSum = 0.0;
+    runBenchmark("scan d: vector<AnyNMEAMessage>", 20, [&] {
+        double sum = 0.0;
+        for (const auto& m : messages)
+            if (m.isType<GGAMessage>())
+                sum += m.get<GGAMessage>().d;
+        vectorSum = sum;
+        doNotOptimize(sum);
+    }, count);
+
+    double columnSum = 0.0;
+    runBenchmark("scan d: NMEAColumnStore column", 20, [&] {
+        double sum = 0.0;
+        for (double d : store.column<&GGAMessage::d>())
+            sum += d;
+        columnSum = sum;
+        doNotOptimize(sum);
+    }, count);
+
+    // Four independent accumulators: what a vectorizing consumer of the exported column does
+    runBenchmark("scan d: exported column, 4 lanes", 20, [&] {
+        const auto column = store.column<&GGAMessage::d>();
+        const double* d = column.data();
+        double lane[4] = {0.0, 0.0, 0.0, 0.0};
+        std::size_t i = 0;
+        for (; i + 4 <= column.size(); i += 4)
+            for (int l = 0; l < 4; ++l)
+                lane[l] += d[i + l];
+        for (; i < column.size(); ++i)
+            lane[0] += d[i];
+        doNotOptimize(lane[0] + lane[1] + lane[2] + lane[3]);
+    }, count);
+
+    if (vectorSum != columnSum)
+    {
+        std::printf("mismatch: %f != %f\n", vectorSum, columnSum);
+        return 1;
+    }
+    return 0;
+}
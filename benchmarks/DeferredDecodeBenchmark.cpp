@@ -0,0 +1,216 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2025 Mark Wilson
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+//  https://www.boost.org/LICENSE_1_0.txt)
+//-----------------------------------------------------------------------------
+//
+// A gateway that looks into only some of its traffic: NMEAMessageRegistry::decode (every
+// payload extracted up front) against decodeDeferred (payload extracted on first get<T>()).
+// "filter" reads the payload of one sentence in ten, routing the rest on type and header
+// alone; "forward" reads nothing and re-serializes every message into an output buffer;
+// "read all" is the worst case for deferral. The allocations column counts global operator
+// new calls per sentence. Before timing, every sentence is checked to serialize to the same
+// bytes both ways.
+//
+// Usage: DeferredDecodeBenchmark [sentences]
+//
+#include <array>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "ExampleMessages.h"
+#include "MutableBuffer.h"
+#include "NMEAInsertionStream.h"
+#include "NMEAMessageRegistry.h"
+
+#include "AllocationCounter.h"
+#include "BenchmarkHarness.h"
+#include "NMEACorpusGenerator.h"
+
+namespace {
+
+// A position fix with as many fields as a real GGA
+struct FixMessage
+{
+    std::array<double, 12> fields {};
+};
+
+// Leaves the trailer to the caller, like most hand-written types
+NMEAInsertionStream& operator<<(NMEAInsertionStream& stream, const FixMessage& msg)
+{
+    stream << NMEAInsertionStream::FloatFormat{2};
+    for (double d : msg.fields)
+        stream << d;
+    return stream;
+}
+
+NMEAExtractionStream& operator>>(NMEAExtractionStream& stream, FixMessage& msg)
+{
+    for (double& d : msg.fields)
+        stream >> d;
+    return stream;
+}
+
+} // namespace
+
+template <>
+struct NMEATraits<FixMessage>
+{
+    static constexpr NMEAMessageName messageName() { return "FIX"; }
+};
+
+namespace {
+
+using Registry = NMEAMessageRegistry<GGAMessage, RMCMessage, FixMessage>;
+
+// Serializes m into out as a whole sentence, adding the trailer if m's type leaves it to
+// the caller, as NMEABatchEncoder does. @return The sentence, empty if it did not fit.
+template <std::size_t N>
+std::string_view encode(const AnyNMEAMessage& m, char (&out)[N])
+{
+    MutableBuffer buffer(out, N);
+    NMEAInsertionStream stream(buffer, m.getHeader());
+    m.serialize(stream);
+    if (!stream.isComplete() && !stream.overflowed())
+        stream << NMEAInsertionStream::EndMsg();
+    return stream.isComplete() ? std::string_view(out, stream.size()) : std::string_view();
+}
+
+// A deferred message writes back the fields it was given, trailer included; an eager one
+// formats its payload. They agree on sentences already in the eager formatting, which is
+// all this corpus holds.
+bool serializesAlike(const std::vector<ImmutableBuffer>& input)
+{
+    NMEAExtractionStream eagerStream(NMEAFieldScan::Eager);
+    NMEAExtractionStream lazyStream(NMEAFieldScan::Lazy);
+    char eagerOut[128];
+    char deferredOut[128];
+    for (const ImmutableBuffer& sentence : input)
+    {
+        eagerStream.rebind(sentence);
+        lazyStream.rebind(sentence);
+        const std::string_view eager = encode(Registry::decode(eagerStream), eagerOut);
+
+        // No help with the trailer here: serialize() alone must finish the sentence
+        const AnyNMEAMessage m = Registry::decodeDeferred(lazyStream);
+        MutableBuffer buffer(deferredOut, sizeof(deferredOut));
+        NMEAInsertionStream stream(buffer, m.getHeader());
+        m.serialize(stream);
+        const std::string_view deferred(deferredOut, stream.isComplete() ? stream.size() : 0);
+
+        if (eager.empty() || eager != deferred)
+        {
+            // The sentence ends in its own "\r\n"
+            std::printf("decode and decodeDeferred serialize differently: %.*s",
+                        static_cast<int>(sentence.size()), sentence.data());
+            return false;
+        }
+    }
+    return true;
+}
+
+double readPayload(const AnyNMEAMessage& m)
+{
+    if (const FixMessage* fix = m.tryGet<FixMessage>())
+        return fix->fields[0];
+    if (const GGAMessage* gga = m.tryGet<GGAMessage>())
+        return gga->d;
+    if (const RMCMessage* rmc = m.tryGet<RMCMessage>())
+        return rmc->d;
+    return 0.0;
+}
+
+template <class Decode, class Use>
+void run(const char* label, const std::vector<ImmutableBuffer>& input, NMEAFieldScan scan, Decode decode, Use use)
+{
+    auto body = [&] {
+        NMEAExtractionStream stream(scan);
+        double sum = 0.0;
+        for (std::size_t i = 0; i < input.size(); ++i)
+        {
+            stream.rebind(input[i]);
+            const AnyNMEAMessage m = decode(stream);
+            sum += use(i, m);
+        }
+        doNotOptimize(sum);
+    };
+
+    const std::size_t before = allocationCount();
+    body();
+    const double allocations = static_cast<double>(allocationCount() - before) / input.size();
+
+    char name[96];
+    std::snprintf(name, sizeof(name), "%s (%.2f allocs/sentence)", label, allocations);
+    runBenchmark(name, 10, body, input.size());
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const std::size_t count = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 60000;
+
+    std::vector<std::string> storage;
+    storage.reserve(count);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        // Doubles in the digits each type writes, so both modes serialize the same bytes
+        const std::string n = std::to_string(i % 997);
+        switch (i % 3)
+        {
+        case 0: storage.push_back(makeNMEASentence("GPGGA," + n + "," + n + ".500000,FIX")); break;
+        case 1: storage.push_back(makeNMEASentence("GPRMC," + n + "," + n + ".250000")); break;
+        default:
+        {
+            std::string body = "GPFIX";
+            char field[16];
+            for (int f = 0; f < 12; ++f)
+            {
+                std::snprintf(field, sizeof(field), ",%s.%02d", n.c_str(), f * 7 % 100);
+                body += field;
+            }
+            storage.push_back(makeNMEASentence(body));
+        }
+        }
+    }
+
+    std::vector<ImmutableBuffer> input;
+    input.reserve(count);
+    for (const auto& s : storage)
+        input.emplace_back(s.data(), s.size());
+
+    std::printf("%zu sentences over %zu types\n", count, Registry::size());
+    if (!serializesAlike(input))
+        return 1;
+
+    auto eager = [](NMEAExtractionStream& stream) { return Registry::decode(stream); };
+    auto deferred = [](NMEAExtractionStream& stream) { return Registry::decodeDeferred(stream); };
+
+    auto filter = [](std::size_t i, const AnyNMEAMessage& m) {
+        double value = m.getTalker() == "GP" ? 1.0 : 0.0;
+        if (i % 10 == 0)
+            value += readPayload(m);
+        return value;
+    };
+
+    char out[128];
+    auto forward = [&out](std::size_t, const AnyNMEAMessage& m) {
+        return static_cast<double>(encode(m, out).size());
+    };
+
+    auto readAll = [](std::size_t, const AnyNMEAMessage& m) { return readPayload(m); };
+
+    run("filter, read 1 in 10: decode", input, NMEAFieldScan::Eager, eager, filter);
+    run("filter, read 1 in 10: decodeDeferred", input, NMEAFieldScan::Lazy, deferred, filter);
+    run("forward, serialize: decode", input, NMEAFieldScan::Eager, eager, forward);
+    run("forward, serialize: decodeDeferred", input, NMEAFieldScan::Lazy, deferred, forward);
+    run("read all: decode", input, NMEAFieldScan::Eager, eager, readAll);
+    run("read all: decodeDeferred", input, NMEAFieldScan::Lazy, deferred, readAll);
+
+    return 0;
+}
@@ -0,0 +1,139 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2025 Mark Wilson
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+//  https://www.boost.org/LICENSE_1_0.txt)
+//-----------------------------------------------------------------------------
+//
+// Compares the cost of routing messages by type through AnyNMEAMessage's operations
+// table against the original virtual Concept + std::type_info design.
+//
+#include <memory>
+#include <typeinfo>
+#include <vector>
+
+#include "AnyNMEAMessage.h"
+#include "ExampleMessages.h"
+#include "NMEAExceptions.h"
+
+#include "BenchmarkHarness.h"
+
+namespace {
+
+struct VTGMessage { double course{1.0}; double speed{2.0}; };
+struct ZDAMessage { int day{1}; int month{2}; int year{2025}; };
+
+//
+// The dispatch core AnyNMEAMessage used before the operations table: a virtual
+// Concept whose type() is compared against typeid(T).
+//
+class LegacyAnyMessage
+{
+public:
+    template <class T>
+    explicit LegacyAnyMessage(T value) : self_(std::make_unique<Model<T>>(std::move(value))) {}
+
+    LegacyAnyMessage(const LegacyAnyMessage& o) : self_(o.self_->clone()) {}
+
+    template <class T>
+    bool isType() const { return self_ && self_->type() == typeid(T); }
+
+    template <class T>
+    const T& get() const
+    {
+        if (!isType<T>()) NMEA_THROW(std::bad_cast());
+        return static_cast<const Model<T>*>(self_.get())->value_;
+    }
+
+private:
+    struct Concept
+    {
+        virtual ~Concept() = default;
+        virtual std::unique_ptr<Concept> clone() const = 0;
+        virtual const std::type_info& type() const noexcept = 0;
+    };
+
+    template <class T>
+    struct Model final : Concept
+    {
+        explicit Model(T v) : value_(std::move(v)) {}
+        std::unique_ptr<Concept> clone() const override { return std::make_unique<Model<T>>(value_); }
+        const std::type_info& type() const noexcept override { return typeid(T); }
+        T value_;
+    };
+
+    std::unique_ptr<Concept> self_;
+};
+
+template <class Message>
+double route(const std::vector<Message>& messages)
+{
+    double sum = 0.0;
+    for (const auto& m : messages)
+    {
+        if (m.template isType<GGAMessage>())
+            sum += m.template get<GGAMessage>().d;
+        else if (m.template isType<RMCMessage>())
+            sum += m.template get<RMCMessage>().d;
+        else if (m.template isType<VTGMessage>())
+            sum += m.template get<VTGMessage>().speed;
+        else if (m.template isType<ZDAMessage>())
+            sum += m.template get<ZDAMessage>().year;
+    }
+    return sum;
+}
+
+} // namespace
+
+template<>
+struct NMEATraits<VTGMessage>
+{
+    static constexpr NMEAMessageName messageName() { return "VTG"; }
+};
+
+template<>
+struct NMEATraits<ZDAMessage>
+{
+    static constexpr NMEAMessageName messageName() { return "ZDA"; }
+};
+
+NMEAInsertionStream& operator<<(NMEAInsertionStream& stream, const VTGMessage&) { return stream; }
+NMEAExtractionStream& operator>>(NMEAExtractionStream& stream, VTGMessage&) { return stream; }
+NMEAInsertionStream& operator<<(NMEAInsertionStream& stream, const ZDAMessage&) { return stream; }
+NMEAExtractionStream& operator>>(NMEAExtractionStream& stream, ZDAMessage&) { return stream; }
+
+int main()
+{
+    constexpr std::size_t Count = 1024;
+
+    std::vector<AnyNMEAMessage> current;
+    std::vector<LegacyAnyMessage> legacy;
+    current.reserve(Count);
+    legacy.reserve(Count);
+
+    for (std::size_t i = 0; i < Count; ++i)
+    {
+        switch (i % 4)
+        {
+        case 0: current.emplace_back("GP", GGAMessage{}); legacy.emplace_back(GGAMessage{}); break;
+        case 1: current.emplace_back("GP", RMCMessage{}); legacy.emplace_back(RMCMessage{}); break;
+        case 2: current.emplace_back("GP", VTGMessage{}); legacy.emplace_back(VTGMessage{}); break;
+        case 3: current.emplace_back("GP", ZDAMessage{}); legacy.emplace_back(ZDAMessage{}); break;
+        }
+    }
+
+    runBenchmark("route/virtual+typeid", 2000, [&] { doNotOptimize(route(legacy)); }, Count);
+    runBenchmark("route/operations-table", 2000, [&] { doNotOptimize(route(current)); }, Count);
+
+    runBenchmark("copy/virtual+make_unique", 2000, [&] {
+        auto copy = legacy;
+        doNotOptimize(copy);
+    }, Count);
+    runBenchmark("copy/operations-table+inline", 2000, [&] {
+        auto copy = current;
+        doNotOptimize(copy);
+    }, Count);
+
+    return 0;
+}
@@ -0,0 +1,118 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2025 Mark Wilson
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+//  https://www.boost.org/LICENSE_1_0.txt)
+//-----------------------------------------------------------------------------
+//
+// Routing a stream of messages over 4, 16 and 64 payload types: an if / else if chain of
+// isType<T>() + get<T>() against NMEADispatcher's table lookup. The chain's cost grows with
+// the number of types (on average half the chain is walked), the dispatcher's should not.
+//
+#include <cstdio>
+#include <utility>
+#include <vector>
+
+#include "AnyNMEAMessage.h"
+#include "NMEADispatcher.h"
+#include "NMEAExtractionStream.h"
+#include "NMEAInsertionStream.h"
+
+#include "BenchmarkHarness.h"
+
+namespace {
+
+// Stand-ins for a large catalogue of sentence types
+template <int N>
+struct SyntheticMessage
+{
+    int value {N};
+};
+
+template <int N>
+NMEAInsertionStream& operator<<(NMEAInsertionStream& stream, const SyntheticMessage<N>& msg)
+{
+    return stream << msg.value;
+}
+
+template <int N>
+NMEAExtractionStream& operator>>(NMEAExtractionStream& stream, SyntheticMessage<N>& msg)
+{
+    return stream >> msg.value;
+}
+
+template <int N>
+AnyNMEAMessage makeMessage()
+{
+    const char name[] = {'X', static_cast<char>('0' + N / 10), static_cast<char>('0' + N % 10), 0};
+    return AnyNMEAMessage("GP", name, SyntheticMessage<N> {});
+}
+
+template <int... I>
+std::vector<AnyNMEAMessage> makeMessages(std::integer_sequence<int, I...>, std::size_t count)
+{
+    constexpr int Types = sizeof...(I);
+    using Factory = AnyNMEAMessage (*)();
+    const Factory factories[] = {&makeMessage<I>...};
+
+    // A fixed, uneven order so the branch predictor cannot learn it
+    std::vector<AnyNMEAMessage> messages;
+    messages.reserve(count);
+    for (std::size_t i = 0; i < count; ++i)
+        messages.push_back(factories[(i * 7919 + i / 3) % Types]());
+    return messages;
+}
+
+template <int... I>
+long routeByChain(std::integer_sequence<int, I...>, const std::vector<AnyNMEAMessage>& messages)
+{
+    long sum = 0;
+    for (const auto& m : messages)
+    {
+        // Expands to if (isType<0>) ... else if (isType<1>) ... in order
+        (void)((m.isType<SyntheticMessage<I>>() ? (sum += m.get<SyntheticMessage<I>>().value, true) : false) || ...);
+    }
+    return sum;
+}
+
+template <int... I>
+void subscribeAll(std::integer_sequence<int, I...>, NMEADispatcher& dispatcher, long& sum)
+{
+    (dispatcher.subscribe<SyntheticMessage<I>>([&sum](const SyntheticMessage<I>& m) { sum += m.value; }), ...);
+}
+
+template <int Types>
+void compare(std::size_t count)
+{
+    const auto types = std::make_integer_sequence<int, Types> {};
+    const std::vector<AnyNMEAMessage> messages = makeMessages(types, count);
+
+    long sum = 0;
+    NMEADispatcher dispatcher;
+    subscribeAll(types, dispatcher, sum);
+
+    char name[64];
+    std::snprintf(name, sizeof(name), "isType chain, %2d types", Types);
+    runBenchmark(name, 200, [&] { doNotOptimize(routeByChain(types, messages)); }, count);
+
+    std::snprintf(name, sizeof(name), "NMEADispatcher, %2d types", Types);
+    runBenchmark(name, 200, [&] {
+        for (const auto& m : messages)
+            dispatcher.dispatch(m);
+        doNotOptimize(sum);
+    }, count);
+}
+
+} // namespace
+
+int main()
+{
+    constexpr std::size_t Count = 4096;
+
+    compare<4>(Count);
+    compare<16>(Count);
+    compare<64>(Count);
+
+    return 0;
+}
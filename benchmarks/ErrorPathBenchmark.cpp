@@ -0,0 +1,114 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2025 Mark Wilson
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+//  https://www.boost.org/LICENSE_1_0.txt)
+//-----------------------------------------------------------------------------
+//
+// The cost of rejecting a bad sentence: decode + get<T>() with the std::bad_cast caught,
+// against tryDecode() + tryGet<T>() and against also quarantining the rejects. Every other
+// sentence has a damaged checksum.
+//
+// Usage: ErrorPathBenchmark [sentences]
+//
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <typeinfo>
+#include <vector>
+
+#include "ExampleMessages.h"
+#include "NMEAExceptions.h"
+#include "NMEAMessageRegistry.h"
+#include "NMEAQuarantineRing.h"
+
+#include "BenchmarkHarness.h"
+#include "NMEACorpusGenerator.h"
+
+namespace {
+
+using Registry = NMEAMessageRegistry<GGAMessage, RMCMessage>;
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const std::size_t count = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 100000;
+
+    std::vector<std::string> storage;
+    storage.reserve(count);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        storage.push_back(makeNMEASentence("GPGGA," + std::to_string(i % 1000) + "," + std::to_string(i % 977) + ".125,FIX"));
+        if (i % 2 == 1)
+            storage.back()[8] ^= 1;
+    }
+
+    std::vector<ImmutableBuffer> input;
+    input.reserve(count);
+    for (const auto& s : storage)
+        input.emplace_back(s.data(), s.size());
+
+    std::printf("%zu sentences, half of them with a bad checksum\n", count);
+
+#if NMEA_HAS_EXCEPTIONS
+    runBenchmark("decode + get<T>, catch std::bad_cast", 5, [&] {
+        NMEAExtractionStream stream;
+        int sum = 0;
+        for (const auto& sentence : input)
+        {
+            stream.rebind(sentence);
+            NMEADecodeStatus status;
+            AnyNMEAMessage m = Registry::decode(stream, status);
+            try
+            {
+                sum += m.get<GGAMessage>().i;
+            }
+            catch (const std::bad_cast&)
+            {
+                --sum;
+            }
+        }
+        doNotOptimize(sum);
+    }, count);
+#endif
+
+    runBenchmark("tryDecode + tryGet<T>", 5, [&] {
+        NMEAExtractionStream stream;
+        AnyNMEAMessage m;
+        int sum = 0;
+        for (const auto& sentence : input)
+        {
+            stream.rebind(sentence);
+            Registry::tryDecode(stream, m);
+            if (const GGAMessage* gga = m.tryGet<GGAMessage>())
+                sum += gga->i;
+            else
+                --sum;
+        }
+        doNotOptimize(sum);
+    }, count);
+
+    NMEAQuarantineRing quarantine(1024);
+    runBenchmark("tryDecode + tryGet<T> + quarantine", 5, [&] {
+        NMEAExtractionStream stream;
+        AnyNMEAMessage m;
+        int sum = 0;
+        for (const auto& sentence : input)
+        {
+            stream.rebind(sentence);
+            const NMEADecodeStatus status = Registry::tryDecode(stream, m);
+            if (const GGAMessage* gga = m.tryGet<GGAMessage>())
+                sum += gga->i;
+            else
+                quarantine.push(std::string_view(sentence.data(), sentence.size()), status);
+        }
+        doNotOptimize(sum);
+    }, count);
+
+    std::printf("quarantine holds %zu of %llu rejects, %llu dropped\n", quarantine.snapshot().size(),
+                static_cast<unsigned long long>(quarantine.pushed()),
+                static_cast<unsigned long long>(quarantine.dropped()));
+    return 0;
+}
@@ -0,0 +1,53 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2025 Mark Wilson
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+//  https://www.boost.org/LICENSE_1_0.txt)
+//-----------------------------------------------------------------------------
+//
+// Steady-state GGAMessage decode through one reused NMEAExtractionStream. Exits non-zero
+// if decoding allocates.
+//
+#include <cstdio>
+#include <cstring>
+
+#include "ExampleMessages.h"
+#include "ImmutableBuffer.h"
+#include "NMEAExtractionStream.h"
+
+#include "AllocationCounter.h"
+#include "BenchmarkHarness.h"
+
+int main()
+{
+    const char* sentence = "$GPGGA,7,1.5,HELLO*25";
+    ImmutableBuffer ib(sentence, std::strlen(sentence));
+
+    NMEAExtractionStream stream;
+    GGAMessage gga;
+
+    constexpr std::size_t Iterations = 1000000;
+
+    auto decode = [&] {
+        stream.rebind(ib);
+        stream >> gga;
+        doNotOptimize(gga);
+    };
+
+    runBenchmark("extract/GGAMessage rebind+decode", Iterations, decode);
+
+    std::size_t before = allocationCount();
+    for (std::size_t i = 0; i < Iterations; ++i)
+        decode();
+    std::size_t allocations = allocationCount() - before;
+
+    std::printf("allocations/op: %.3f\n", static_cast<double>(allocations) / Iterations);
+
+    if (gga.i != 7 || gga.s != "HELLO")
+    {
+        std::printf("decode produced wrong values: %d %s\n", gga.i, gga.s.c_str());
+        return 1;
+    }
+    return allocations == 0 ? 0 : 1;
+}
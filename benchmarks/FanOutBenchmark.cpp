@@ -0,0 +1,111 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2025 Mark Wilson
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+//  https://www.boost.org/LICENSE_1_0.txt)
+//-----------------------------------------------------------------------------
+//
+// Fanning one decoded message out to N consumers (logger, display, fusion filter...):
+// every consumer gets its own AnyNMEAMessage and reads a field of it. Deep copies against
+// AnyNMEAMessage::makeShared(), for a payload that fits inline and for one that does not.
+// The allocations column counts global operator new calls per fanned-out message.
+//
+// Usage: FanOutBenchmark [maxReaders]
+//
+#include <array>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "AnyNMEAMessage.h"
+#include "ExampleMessages.h"
+#include "NMEAExtractionStream.h"
+#include "NMEAInsertionStream.h"
+
+#include "AllocationCounter.h"
+#include "BenchmarkHarness.h"
+
+namespace {
+
+// Satellites in view with a free text comment: too big for the inline buffer
+struct GSVMessage
+{
+    std::array<double, 16> elevation {};
+    std::string comment;
+};
+
+static_assert(!AnyNMEAMessage::storesInline<GSVMessage>(), "GSVMessage must take the allocating path");
+
+NMEAInsertionStream& operator<<(NMEAInsertionStream& stream, const GSVMessage& msg)
+{
+    return stream << msg.comment;
+}
+
+NMEAExtractionStream& operator>>(NMEAExtractionStream& stream, GSVMessage& msg)
+{
+    return stream >> msg.comment;
+}
+
+constexpr std::size_t Messages = 20000;
+
+template <class T, class Read>
+void fanOut(const char* label, const AnyNMEAMessage& source, std::size_t readers, Read read)
+{
+    std::vector<AnyNMEAMessage> consumers(readers);
+
+    auto body = [&] {
+        double sum = 0.0;
+        for (std::size_t m = 0; m < Messages; ++m)
+        {
+            for (auto& consumer : consumers)
+                consumer = source;
+            for (const auto& consumer : consumers)
+                sum += read(consumer.get<T>());
+        }
+        doNotOptimize(sum);
+    };
+
+    const std::size_t before = allocationCount();
+    body();
+    const double allocations = static_cast<double>(allocationCount() - before) / Messages;
+
+    char name[96];
+    std::snprintf(name, sizeof(name), "%s, %2zu readers (%.1f allocs/msg)", label, readers, allocations);
+    runBenchmark(name, 5, body, Messages);
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const std::size_t maxReaders = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 16;
+
+    // A text field past the small string buffer, so a deep copy allocates for it too
+    GGAMessage gga {42, 4807.038, "a fix from the antenna on the mast"};
+    GSVMessage gsv;
+    gsv.elevation.fill(45.0);
+    gsv.comment = "sixteen satellites in view, all of them healthy";
+
+    const AnyNMEAMessage ggaCopied("GP", gga);
+    AnyNMEAMessage ggaShared("GP", gga);
+    ggaShared.makeShared();
+
+    const AnyNMEAMessage gsvCopied("GP", "GSV", gsv);
+    AnyNMEAMessage gsvShared("GP", "GSV", gsv);
+    gsvShared.makeShared();
+
+    auto readGGA = [](const GGAMessage& m) { return m.d; };
+    auto readGSV = [](const GSVMessage& m) { return m.elevation[3]; };
+
+    for (std::size_t readers = 1; readers <= maxReaders; readers *= 2)
+    {
+        fanOut<GGAMessage>("GGA (inline), copied", ggaCopied, readers, readGGA);
+        fanOut<GGAMessage>("GGA (inline), shared", ggaShared, readers, readGGA);
+        fanOut<GSVMessage>("GSV (heap),   copied", gsvCopied, readers, readGSV);
+        fanOut<GSVMessage>("GSV (heap),   shared", gsvShared, readers, readGSV);
+    }
+
+    return 0;
+}
@@ -0,0 +1,99 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2025 Mark Wilson
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+//  https://www.boost.org/LICENSE_1_0.txt)
+//-----------------------------------------------------------------------------
+//
+// A selective consumer reading field 2 of 20 field sentences, and one reading all of them,
+// with NMEAExtractionStream's eager scan (every field and the checksum at rebind()) against
+// NMEAFieldScan::Lazy (only as far as the fields read).
+//
+// Usage: FieldCursorBenchmark [sentences]
+//
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "ImmutableBuffer.h"
+#include "NMEAExtractionStream.h"
+
+#include "BenchmarkHarness.h"
+#include "NMEACorpusGenerator.h"
+
+namespace {
+
+constexpr int Fields = 20;
+
+std::string makeSentence(std::size_t i)
+{
+    std::string body = "GPGSV";
+    for (int f = 0; f < Fields; ++f)
+        body += "," + std::to_string((i + f) % 90) + "." + std::to_string((i * 7 + f) % 100);
+    return makeNMEASentence(body);
+}
+
+template <class Read>
+void run(const char* name, NMEAFieldScan scan, const std::vector<ImmutableBuffer>& input, Read read)
+{
+    runBenchmark(name, 20, [&] {
+        NMEAExtractionStream stream(scan);
+        double sum = 0.0;
+        for (const auto& sentence : input)
+        {
+            stream.rebind(sentence);
+            sum += read(stream);
+        }
+        doNotOptimize(sum);
+    }, input.size());
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const std::size_t count = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 20000;
+
+    std::vector<std::string> storage;
+    storage.reserve(count);
+    for (std::size_t i = 0; i < count; ++i)
+        storage.push_back(makeSentence(i));
+
+    std::vector<ImmutableBuffer> input;
+    input.reserve(count);
+    for (const auto& s : storage)
+        input.emplace_back(s.data(), s.size());
+
+    std::printf("%zu sentences of %d fields, %zu bytes each\n", count, Fields, storage.front().size());
+
+    auto second = [](NMEAExtractionStream& stream) {
+        double d;
+        stream >> NMEAExtractionStream::Seek{2} >> d;
+        return d;
+    };
+
+    auto all = [](NMEAExtractionStream& stream) {
+        double sum = 0.0;
+        for (int f = 0; f < Fields; ++f)
+        {
+            double d;
+            stream >> d;
+            sum += d;
+        }
+        return sum;
+    };
+
+    auto secondChecked = [&second](NMEAExtractionStream& stream) {
+        return stream.isChecksumValid() ? second(stream) : 0.0;
+    };
+
+    run("field 2 only, eager", NMEAFieldScan::Eager, input, second);
+    run("field 2 only, lazy", NMEAFieldScan::Lazy, input, second);
+    run("field 2 only + checksum, lazy", NMEAFieldScan::Lazy, input, secondChecked);
+    run("all 20 fields, eager", NMEAFieldScan::Eager, input, all);
+    run("all 20 fields, lazy", NMEAFieldScan::Lazy, input, all);
+
+    return 0;
+}
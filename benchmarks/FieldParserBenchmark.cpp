@@ -0,0 +1,95 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2025 Mark Wilson
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+//  https://www.boost.org/LICENSE_1_0.txt)
+//-----------------------------------------------------------------------------
+//
+// The NMEA numeric field parsers against strtod/strtol on the numeric fields of a
+// GGA/RMC corpus.
+//
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "ImmutableBuffer.h"
+#include "NMEAExtractionStream.h"
+#include "NMEAFieldParsers.h"
+
+#include "BenchmarkHarness.h"
+
+int main()
+{
+    const std::vector<std::string> corpus {
+        "$GPGGA,123519,4807.038,N,01131.000,E,1,08,0.9,545.4,M,46.9,M,,*47",
+        "$GPGGA,092750.000,5321.6802,N,00630.3372,W,1,8,1.03,61.7,M,55.2,M,,*76",
+        "$GPRMC,123519,A,4807.038,N,01131.000,E,022.4,084.4,230394,003.1,W*6A",
+        "$GPRMC,225446,A,4916.45,N,12311.12,W,000.5,054.7,191194,020.3,E*68",
+    };
+
+    // Collect every numeric field; the strtod baseline needs them NUL terminated.
+    std::vector<std::string_view> fields;
+    std::vector<std::string> terminated;
+    std::vector<std::string_view> intFields;
+    std::vector<std::string> intTerminated;
+    for (const auto& s : corpus)
+    {
+        ImmutableBuffer ib(s.data(), s.size());
+        NMEAExtractionStream stream(ib);
+        for (std::size_t i = 1; i < stream.numberOfFields(); ++i)
+        {
+            std::string_view f;
+            stream >> f;
+            double d;
+            if (parseNMEADouble(f, d) == NMEAFieldStatus::Ok)
+            {
+                fields.push_back(f);
+                terminated.emplace_back(f);
+            }
+            int n;
+            if (parseNMEAInt(f, n) == NMEAFieldStatus::Ok)
+            {
+                intFields.push_back(f);
+                intTerminated.emplace_back(f);
+            }
+        }
+    }
+    std::printf("%zu numeric fields, %zu of them integers\n", fields.size(), intFields.size());
+
+    constexpr std::size_t Iterations = 200000;
+
+    auto strtodResult = runBenchmark("double/strtod", Iterations, [&] {
+        for (const auto& f : terminated)
+            doNotOptimize(std::strtod(f.c_str(), nullptr));
+    }, terminated.size());
+
+    auto nmeaResult = runBenchmark("double/parseNMEADouble", Iterations, [&] {
+        for (auto f : fields)
+        {
+            double d;
+            doNotOptimize(parseNMEADouble(f, d));
+            doNotOptimize(d);
+        }
+    }, fields.size());
+
+    auto strtolResult = runBenchmark("int/strtol", Iterations, [&] {
+        for (const auto& f : intTerminated)
+            doNotOptimize(std::strtol(f.c_str(), nullptr, 10));
+    }, intTerminated.size());
+
+    auto intResult = runBenchmark("int/parseNMEAInt", Iterations, [&] {
+        for (auto f : intFields)
+        {
+            int i;
+            doNotOptimize(parseNMEAInt(f, i));
+            doNotOptimize(i);
+        }
+    }, intFields.size());
+
+    std::printf("speedup: double %.1fx, int %.1fx\n",
+                strtodResult.nsPerOp / nmeaResult.nsPerOp, strtolResult.nsPerOp / intResult.nsPerOp);
+    return 0;
+}
@@ -0,0 +1,77 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2025 Mark Wilson
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+//  https://www.boost.org/LICENSE_1_0.txt)
+//-----------------------------------------------------------------------------
+//
+// GGAMessage encode throughput: NMEAInsertionStream against the sprintf based encoder it
+// replaced (minus the printf of every sentence, which would dominate).
+//
+#include <array>
+#include <cstdio>
+#include <cstring>
+
+#include "ExampleMessages.h"
+#include "MutableBuffer.h"
+#include "NMEACommon.h"
+#include "NMEAInsertionStream.h"
+
+#include "BenchmarkHarness.h"
+
+namespace {
+
+// The original field formatting: sprintf per field, checksum by a separate walk.
+std::size_t legacyEncode(char* buffer, const GGAMessage& msg)
+{
+    char* p = buffer;
+    *p++ = '$';
+    std::strcpy(p, "GP");
+    p += std::strlen("GP");
+    std::strcpy(p, "GGA");
+    p += std::strlen("GGA");
+    *p++ = ',';
+
+    p += std::sprintf(p, "%d,", msg.i);
+    p += std::sprintf(p, "%f,", msg.d);
+    std::strcpy(p, msg.s.c_str());
+    p += msg.s.size();
+    *p++ = ',';
+
+    p--;
+    *p = 0;
+    std::uint8_t cs = calculateNMEAChecksum(buffer);
+    std::sprintf(p, "*%xc", cs);
+    p += 3;
+    std::strcpy(p, "\r\n");
+    p += 2;
+
+    return static_cast<std::size_t>(p - buffer);
+}
+
+} // namespace
+
+int main()
+{
+    const GGAMessage gga { 1, 43.34, "HELLO" };
+    std::array<char, 128> storage;
+
+    constexpr std::size_t Iterations = 1000000;
+
+    auto legacy = runBenchmark("encode/GGAMessage sprintf", Iterations, [&] {
+        doNotOptimize(legacyEncode(storage.data(), gga));
+        doNotOptimize(storage);
+    });
+
+    auto current = runBenchmark("encode/GGAMessage NMEAInsertionStream", Iterations, [&] {
+        MutableBuffer mb = buffer(storage);
+        NMEAInsertionStream nis(mb, "GP", "GGA");
+        nis << gga;
+        doNotOptimize(nis.size());
+        doNotOptimize(storage);
+    });
+
+    std::printf("speedup: %.1fx\n", legacy.nsPerOp / current.nsPerOp);
+    return 0;
+}
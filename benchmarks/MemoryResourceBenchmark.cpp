@@ -0,0 +1,142 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2025 Mark Wilson
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+//  https://www.boost.org/LICENSE_1_0.txt)
+//-----------------------------------------------------------------------------
+//
+// Multi-threaded churn of messages too large for the inline buffer: every thread builds
+// a frame of messages, copies some, and drops the frame, over and over. Compares the
+// default heap, threadLocalNMEAMessageResource(), a monotonic arena released per frame
+// and one synchronized pool shared by all threads.
+//
+// Usage: MemoryResourceBenchmark [maxThreads]
+//
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <memory_resource>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "AnyNMEAMessage.h"
+#include "NMEAExtractionStream.h"
+#include "NMEAInsertionStream.h"
+#include "NMEAMemoryResource.h"
+
+#include "BenchmarkHarness.h"
+
+namespace {
+
+// Satellites in view: too big for AnyNMEAMessage::InlineCapacity
+struct GSVMessage
+{
+    std::array<double, 16> elevation {};
+    int count {0};
+};
+
+static_assert(!AnyNMEAMessage::storesInline<GSVMessage>(), "GSVMessage must take the allocating path");
+
+NMEAInsertionStream& operator<<(NMEAInsertionStream& stream, const GSVMessage& msg)
+{
+    return stream << msg.count;
+}
+
+NMEAExtractionStream& operator>>(NMEAExtractionStream& stream, GSVMessage& msg)
+{
+    return stream >> msg.count;
+}
+
+constexpr std::size_t FrameSize = 256;
+constexpr std::size_t FramesPerThread = 200;
+
+// One frame: FrameSize messages built, every fourth copied into the same resource, all dropped.
+void churnFrame(std::vector<AnyNMEAMessage>& frame, std::pmr::memory_resource* resource)
+{
+    for (std::size_t i = 0; i < FrameSize; ++i)
+    {
+        GSVMessage value;
+        value.count = static_cast<int>(i);
+        frame.emplace_back("GP", "GSV", value, resource);
+        if (i % 4 == 0)
+            frame.emplace_back(frame.back(), resource);
+    }
+    doNotOptimize(frame.data());
+    frame.clear();
+}
+
+using ThreadBody = std::function<void()>;
+
+void runThreads(unsigned threads, const ThreadBody& body)
+{
+    std::vector<std::thread> pool;
+    for (unsigned t = 0; t < threads; ++t)
+        pool.emplace_back(body);
+    for (auto& thread : pool)
+        thread.join();
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const unsigned maxThreads = argc > 1 ? static_cast<unsigned>(std::strtoul(argv[1], nullptr, 10))
+                                         : std::max(1u, std::thread::hardware_concurrency());
+    const std::size_t messagesPerThread = FramesPerThread * (FrameSize + FrameSize / 4);
+
+    std::pmr::synchronized_pool_resource shared(nmeaMessagePoolOptions());
+
+    for (unsigned threads = 1; threads <= maxThreads; threads *= 2)
+    {
+        const std::string suffix = ", " + std::to_string(threads) + " thread(s)";
+        const std::size_t ops = threads * messagesPerThread;
+
+        runBenchmark("default heap" + suffix, 3, [&] {
+            runThreads(threads, [] {
+                std::vector<AnyNMEAMessage> frame;
+                frame.reserve(FrameSize * 2);
+                for (std::size_t f = 0; f < FramesPerThread; ++f)
+                    churnFrame(frame, std::pmr::get_default_resource());
+            });
+        }, ops);
+
+        runBenchmark("thread-local pool" + suffix, 3, [&] {
+            runThreads(threads, [] {
+                std::vector<AnyNMEAMessage> frame;
+                frame.reserve(FrameSize * 2);
+                for (std::size_t f = 0; f < FramesPerThread; ++f)
+                    churnFrame(frame, threadLocalNMEAMessageResource());
+            });
+        }, ops);
+
+        runBenchmark("monotonic arena per frame" + suffix, 3, [&] {
+            runThreads(threads, [] {
+                std::vector<char> arena((FrameSize + FrameSize / 4) * (sizeof(GSVMessage) + 16));
+                std::pmr::monotonic_buffer_resource frameResource(arena.data(), arena.size(),
+                                                                  std::pmr::null_memory_resource());
+                std::vector<AnyNMEAMessage> frame;
+                frame.reserve(FrameSize * 2);
+                for (std::size_t f = 0; f < FramesPerThread; ++f)
+                {
+                    churnFrame(frame, &frameResource);
+                    frameResource.release();
+                }
+            });
+        }, ops);
+
+        runBenchmark("shared synchronized pool" + suffix, 3, [&] {
+            runThreads(threads, [&shared] {
+                std::vector<AnyNMEAMessage> frame;
+                frame.reserve(FrameSize * 2);
+                for (std::size_t f = 0; f < FramesPerThread; ++f)
+                    churnFrame(frame, &shared);
+            });
+        }, ops);
+    }
+
+    return 0;
+}
@@ -0,0 +1,143 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2025 Mark Wilson
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+//  https://www.boost.org/LICENSE_1_0.txt)
+//-----------------------------------------------------------------------------
+#include <algorithm>
+#include <cstdio>
+
+#include "NMEACommon.h"
+#include "NMEACorpusGenerator.h"
+
+namespace {
+
+// splitmix64: tiny, fast and specified bit for bit, unlike std::uniform_int_distribution
+class CorpusRandom
+{
+public:
+    explicit CorpusRandom(std::uint64_t seed) : mState(seed) {}
+
+    std::uint64_t next()
+    {
+        std::uint64_t z = (mState += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+    /// @return A value in [0, bound)
+    std::uint64_t below(std::uint64_t bound) { return bound ? next() % bound : 0; }
+
+    /// @return true with the given probability
+    bool chance(double probability)
+    {
+        return static_cast<double>(next() >> 11) * (1.0 / 9007199254740992.0) < probability;
+    }
+
+private:
+    std::uint64_t mState;
+};
+
+void appendNumber(std::string& out, CorpusRandom& random, std::uint64_t integerBound, int decimals)
+{
+    out += std::to_string(random.below(integerBound));
+    if (decimals > 0)
+    {
+        out += '.';
+        for (int i = 0; i < decimals; ++i)
+            out += static_cast<char>('0' + random.below(10));
+    }
+}
+
+void appendText(std::string& out, CorpusRandom& random, std::size_t width)
+{
+    for (std::size_t i = 0; i < width; ++i)
+        out += static_cast<char>('A' + random.below(26));
+}
+
+} // namespace
+
+std::string makeNMEASentence(std::string_view body)
+{
+    char trailer[8];
+    std::snprintf(trailer, sizeof(trailer), "*%02X\r\n", calculateNMEAChecksum(body));
+
+    std::string sentence;
+    sentence.reserve(body.size() + 6);
+    sentence += '$';
+    sentence += body;
+    sentence += trailer;
+    return sentence;
+}
+
+NMEACorpus generateNMEACorpus(const NMEACorpusOptions &options)
+{
+    CorpusRandom random(options.seed);
+    const std::size_t textWidth = std::min<std::size_t>(options.textWidth, 16);
+    const int decimals = std::clamp(options.decimals, 0, 6);
+    const unsigned totalWeight = options.ggaWeight + options.rmcWeight + options.unknownWeight;
+
+    NMEACorpus corpus;
+    std::vector<std::size_t> ends;
+    ends.reserve(options.sentences);
+    corpus.text.reserve(options.sentences * 48);
+
+    std::string body;
+    for (std::size_t n = 0; n < options.sentences; ++n)
+    {
+        body.clear();
+        const std::uint64_t pick = random.below(totalWeight ? totalWeight : 1);
+        if (pick < options.ggaWeight || totalWeight == 0)
+        {
+            body += "GPGGA,";
+            body += std::to_string(random.below(100000));
+            body += ',';
+            appendNumber(body, random, 10000, decimals);
+            body += ',';
+            appendText(body, random, textWidth);
+            ++corpus.gga;
+        }
+        else if (pick < options.ggaWeight + options.rmcWeight)
+        {
+            body += "GNRMC,";
+            body += std::to_string(random.below(100000));
+            body += ',';
+            appendNumber(body, random, 1000, decimals);
+            ++corpus.rmc;
+        }
+        else
+        {
+            body += "GPXDR,";
+            appendNumber(body, random, 100, decimals);
+            body += ",C,";
+            appendText(body, random, 4);
+            ++corpus.unknown;
+        }
+
+        std::string sentence = makeNMEASentence(body);
+        if (options.corruptionRate > 0.0 && random.chance(options.corruptionRate))
+        {
+            if (random.below(2) == 0)
+                sentence[1 + random.below(body.size())] ^= 0x01;
+            else
+                sentence.resize(sentence.size() - 5);
+            ++corpus.corrupted;
+        }
+
+        corpus.text += sentence;
+        ends.push_back(corpus.text.size());
+    }
+
+    // Only now that text is final can views into it be taken
+    corpus.sentences.reserve(ends.size());
+    std::size_t begin = 0;
+    for (std::size_t end : ends)
+    {
+        corpus.sentences.emplace_back(corpus.text.data() + begin, end - begin);
+        begin = end;
+    }
+
+    return corpus;
+}
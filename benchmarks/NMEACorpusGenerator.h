@@ -0,0 +1,68 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2025 Mark Wilson
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+//  https://www.boost.org/LICENSE_1_0.txt)
+//-----------------------------------------------------------------------------
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "ImmutableBuffer.h"
+
+/**
+ * @brief Knobs for generateNMEACorpus(). The same options always give byte-identical output,
+ * on every platform: the generator uses its own PRNG rather than <random> distributions.
+ */
+struct NMEACorpusOptions
+{
+    std::uint64_t seed {1};
+    std::size_t sentences {100000};
+
+    // Relative weights of the sentence mix. Unknown sentences are well formed but carry a
+    // message name no benchmark registers.
+    unsigned ggaWeight {3};
+    unsigned rmcWeight {2};
+    unsigned unknownWeight {1};
+
+    std::size_t textWidth {6};   ///< Characters in GGA's text field, at most 16
+    int decimals {3};            ///< Digits after the point of the floating point fields, 0..6
+    double corruptionRate {0.0}; ///< Fraction of sentences damaged, 0..1
+};
+
+/**
+ * @brief The NMEACorpus struct is a generated capture: every sentence ends in "\r\n" and
+ * they sit back to back in text, with one ImmutableBuffer view per sentence.
+ */
+struct NMEACorpus
+{
+    std::string text;
+    std::vector<ImmutableBuffer> sentences;
+    std::size_t gga {0};
+    std::size_t rmc {0};
+    std::size_t unknown {0};
+    std::size_t corrupted {0}; ///< Half get a payload byte flipped (bad checksum), half lose their trailer
+
+    NMEACorpus() = default;
+    NMEACorpus(const NMEACorpus&) = delete;             // the views point into text
+    NMEACorpus& operator=(const NMEACorpus&) = delete;
+    NMEACorpus(NMEACorpus&&) = default;
+    NMEACorpus& operator=(NMEACorpus&&) = default;
+};
+
+/**
+ * @brief generateNMEACorpus builds a deterministic corpus of GGA, RMC and unknown sentences
+ * matching the strawman schemas in ExampleMessages.h.
+ */
+NMEACorpus generateNMEACorpus(const NMEACorpusOptions& options);
+
+/**
+ * @brief makeNMEASentence frames a payload such as "GPGGA,1,2.5" as "$GPGGA,1,2.5*hh\r\n",
+ * for benchmarks that build their own sentence mix.
+ */
+std::string makeNMEASentence(std::string_view body);
@@ -0,0 +1,248 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2025 Mark Wilson
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+//  https://www.boost.org/LICENSE_1_0.txt)
+//-----------------------------------------------------------------------------
+//
+// Handing AnyNMEAMessage objects from producer to consumer threads: a mutex protected
+// std::deque against NMEAMPMCQueue (spinning and blocking waits) at 1, 2, 4 ... maxThreads
+// producers and as many consumers, and NMEASPSCQueue (one at a time and in batches) for the
+// single pair. Reports throughput and the producer-to-consumer latency distribution.
+//
+// Usage: QueueBenchmark [maxThreads] [messages]
+//
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "AnyNMEAMessage.h"
+#include "NMEAExtractionStream.h"
+#include "NMEAInsertionStream.h"
+#include "NMEAMessageQueue.h"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// The payload carries its send time
+struct StampMessage
+{
+    std::int64_t sentNs {0};
+    int producer {0};
+};
+
+NMEAInsertionStream& operator<<(NMEAInsertionStream& stream, const StampMessage& msg)
+{
+    return stream << msg.producer;
+}
+
+NMEAExtractionStream& operator>>(NMEAExtractionStream& stream, StampMessage& msg)
+{
+    return stream >> msg.producer;
+}
+
+std::int64_t nowNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count();
+}
+
+// What the pipeline used before: an unbounded deque behind one mutex
+class MutexQueue
+{
+public:
+    explicit MutexQueue(std::size_t) {}
+
+    void push(AnyNMEAMessage&& message)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mQueue.push_back(std::move(message));
+        }
+        mNotEmpty.notify_one();
+    }
+
+    void pop(AnyNMEAMessage& out)
+    {
+        std::unique_lock<std::mutex> lock(mMutex);
+        mNotEmpty.wait(lock, [this] { return !mQueue.empty(); });
+        out = std::move(mQueue.front());
+        mQueue.pop_front();
+    }
+
+private:
+    std::mutex mMutex;
+    std::condition_variable mNotEmpty;
+    std::deque<AnyNMEAMessage> mQueue;
+};
+
+// Pushes and pops Batch messages at a time through the SPSC batch calls
+template <std::size_t Batch, class Wait>
+class BatchedSPSC
+{
+public:
+    explicit BatchedSPSC(std::size_t capacity) : mQueue(capacity) {}
+
+    void push(AnyNMEAMessage&& message)
+    {
+        mOut[mOutCount++] = std::move(message);
+        if (mOutCount == Batch || mOut[mOutCount - 1].isEmpty())
+            flush();
+    }
+
+    void pop(AnyNMEAMessage& out)
+    {
+        if (mInNext == mInCount)
+        {
+            mInNext = 0;
+            while ((mInCount = mQueue.tryPopBatch(mIn, Batch)) == 0)
+                std::this_thread::yield();
+        }
+        out = std::move(mIn[mInNext++]);
+    }
+
+private:
+    void flush()
+    {
+        std::size_t pushed = 0;
+        while (pushed < mOutCount)
+        {
+            const std::size_t n = mQueue.tryPushBatch(mOut + pushed, mOutCount - pushed);
+            if (n == 0)
+                std::this_thread::yield();
+            pushed += n;
+        }
+        mOutCount = 0;
+    }
+
+    NMEASPSCQueue<AnyNMEAMessage, Wait> mQueue;
+    AnyNMEAMessage mOut[Batch];
+    std::size_t mOutCount {0};
+    AnyNMEAMessage mIn[Batch];
+    std::size_t mInCount {0};
+    std::size_t mInNext {0};
+};
+
+struct RunResult
+{
+    double opsPerSecond {0.0};
+    std::int64_t p50 {0};
+    std::int64_t p99 {0};
+    std::int64_t p999 {0};
+    std::int64_t max {0};
+};
+
+// producers push messages / producers stamped messages each, then one empty message per
+// consumer tells the consumers to stop.
+template <class Queue>
+RunResult run(unsigned producers, unsigned consumers, std::size_t messages)
+{
+    Queue queue(1024);
+    const std::size_t perProducer = messages / producers;
+    std::vector<std::vector<std::int64_t>> latencies(consumers);
+    for (auto& l : latencies)
+        l.reserve(perProducer * producers / consumers + 1024);
+
+    std::atomic<unsigned> ready {0};
+    std::atomic<bool> go {false};
+    std::vector<std::thread> threads;
+
+    for (unsigned c = 0; c < consumers; ++c)
+        threads.emplace_back([&, c] {
+            ready.fetch_add(1);
+            while (!go.load(std::memory_order_acquire))
+                std::this_thread::yield();
+
+            AnyNMEAMessage message;
+            for (;;)
+            {
+                queue.pop(message);
+                if (message.isEmpty())
+                    break;
+                latencies[c].push_back(nowNs() - message.get<StampMessage>().sentNs);
+            }
+        });
+
+    std::atomic<unsigned> producersLeft {producers};
+    for (unsigned p = 0; p < producers; ++p)
+        threads.emplace_back([&, p] {
+            ready.fetch_add(1);
+            while (!go.load(std::memory_order_acquire))
+                std::this_thread::yield();
+
+            for (std::size_t i = 0; i < perProducer; ++i)
+                queue.push(AnyNMEAMessage("GP", "STP", StampMessage {nowNs(), static_cast<int>(p)}));
+
+            // The last producer out stops the consumers
+            if (producersLeft.fetch_sub(1) == 1)
+                for (unsigned c = 0; c < consumers; ++c)
+                    queue.push(AnyNMEAMessage());
+        });
+
+    while (ready.load() != producers + consumers)
+        std::this_thread::yield();
+
+    const auto start = Clock::now();
+    go.store(true, std::memory_order_release);
+    for (auto& t : threads)
+        t.join();
+    const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    std::vector<std::int64_t> all;
+    for (auto& l : latencies)
+        all.insert(all.end(), l.begin(), l.end());
+    std::sort(all.begin(), all.end());
+
+    RunResult result;
+    result.opsPerSecond = static_cast<double>(all.size()) / seconds;
+    if (!all.empty())
+    {
+        auto at = [&all](double q) { return all[std::min(all.size() - 1, static_cast<std::size_t>(q * all.size()))]; };
+        result.p50 = at(0.50);
+        result.p99 = at(0.99);
+        result.p999 = at(0.999);
+        result.max = all.back();
+    }
+    return result;
+}
+
+template <class Queue>
+void report(const char* name, unsigned producers, unsigned consumers, std::size_t messages)
+{
+    const RunResult r = run<Queue>(producers, consumers, messages);
+    std::printf("%-28s %2u x %-2u %12.0f msg/s   p50 %8lld ns  p99 %10lld ns  p99.9 %10lld ns  max %10lld ns\n",
+                name, producers, consumers, r.opsPerSecond, static_cast<long long>(r.p50),
+                static_cast<long long>(r.p99), static_cast<long long>(r.p999), static_cast<long long>(r.max));
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const unsigned maxThreads = argc > 1 ? static_cast<unsigned>(std::strtoul(argv[1], nullptr, 10)) : 16;
+    const std::size_t messages = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 200000;
+
+    std::printf("%zu messages, %u hardware threads\n", messages, std::thread::hardware_concurrency());
+
+    report<NMEASPSCQueue<AnyNMEAMessage, NMEASpinWait>>("SPSC, spin", 1, 1, messages);
+    report<NMEASPSCQueue<AnyNMEAMessage, NMEABlockingWait>>("SPSC, blocking", 1, 1, messages);
+    report<BatchedSPSC<32, NMEASpinWait>>("SPSC, batches of 32", 1, 1, messages);
+
+    for (unsigned threads = 1; threads <= maxThreads; threads *= 2)
+    {
+        report<MutexQueue>("mutex + std::deque", threads, threads, messages);
+        report<NMEAMPMCQueue<AnyNMEAMessage, NMEASpinWait>>("MPMC, spin", threads, threads, messages);
+        report<NMEAMPMCQueue<AnyNMEAMessage, NMEABlockingWait>>("MPMC, blocking", threads, threads, messages);
+    }
+
+    return 0;
+}
@@ -0,0 +1,145 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2025 Mark Wilson
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+//  https://www.boost.org/LICENSE_1_0.txt)
+//-----------------------------------------------------------------------------
+//
+// Decode throughput of NMEAMessageRegistry with 32 registered sentence types, next to
+// the std::map<std::string, ...> lookup it replaces.
+//
+#include <cstdio>
+#include <functional>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "ImmutableBuffer.h"
+#include "NMEACommon.h"
+#include "NMEAExtractionStream.h"
+#include "NMEAMessageRegistry.h"
+
+#include "BenchmarkHarness.h"
+
+template <std::size_t N>
+struct SyntheticMessage
+{
+    int i{0};
+    double d{0.0};
+};
+
+template <std::size_t N>
+struct NMEATraits<SyntheticMessage<N>>
+{
+    // "SAA", "SAB", ... one distinct name per N.
+    static constexpr NMEAMessageName messageName()
+    {
+        const char name[] = { 'S', static_cast<char>('A' + N / 26), static_cast<char>('A' + N % 26) };
+        return NMEAMessageName(std::string_view(name, 3));
+    }
+};
+
+template <std::size_t N>
+NMEAExtractionStream& operator>>(NMEAExtractionStream& stream, SyntheticMessage<N>& msg)
+{
+    stream >> msg.i;
+    stream >> msg.d;
+    return stream;
+}
+
+template <std::size_t N>
+NMEAInsertionStream& operator<<(NMEAInsertionStream& stream, const SyntheticMessage<N>&) { return stream; }
+
+namespace {
+
+template <class Seq> struct RegistryOf;
+
+template <std::size_t... N>
+struct RegistryOf<std::index_sequence<N...>>
+{
+    using type = NMEAMessageRegistry<SyntheticMessage<N>...>;
+
+    static std::map<std::string, std::function<AnyNMEAMessage(NMEAExtractionStream&)>> makeMap()
+    {
+        std::map<std::string, std::function<AnyNMEAMessage(NMEAExtractionStream&)>> map;
+        ((map[std::string(NMEATraits<SyntheticMessage<N>>::messageName().view())] =
+              [](NMEAExtractionStream& stream) {
+                  SyntheticMessage<N> value;
+                  stream >> value;
+                  return AnyNMEAMessage(stream.getTalker(), std::move(value));
+              }), ...);
+        return map;
+    }
+};
+
+constexpr std::size_t TypeCount = 32;
+using Types = RegistryOf<std::make_index_sequence<TypeCount>>;
+using Registry = Types::type;
+
+std::vector<std::string> makeCorpus(std::size_t count)
+{
+    std::vector<std::string> corpus;
+    corpus.reserve(count);
+
+    for (std::size_t n = 0; n < count; ++n)
+    {
+        std::size_t type = (n * 7) % TypeCount;
+        char body[64];
+        std::snprintf(body, sizeof(body), "$GPS%c%c,%zu,%zu.25",
+                      static_cast<char>('A' + type / 26), static_cast<char>('A' + type % 26), n, n % 1000);
+        std::string sentence(body);
+        sentence += '*';
+        std::snprintf(body, sizeof(body), "%02X",
+                      static_cast<unsigned>(calculateNMEAChecksum(sentence)));
+        sentence += body;
+        corpus.push_back(std::move(sentence));
+    }
+    return corpus;
+}
+
+} // namespace
+
+int main()
+{
+    static_assert(Registry::size() == TypeCount, "all synthetic types registered");
+
+    auto corpus = makeCorpus(4096);
+    std::size_t bytes = 0;
+    for (const auto& s : corpus)
+        bytes += s.size();
+
+    auto map = Types::makeMap();
+
+    auto mapResult = runBenchmark("decode/std::map<std::string>", 200, [&] {
+        for (const auto& s : corpus)
+        {
+            ImmutableBuffer ib(s.data(), s.size());
+            NMEAExtractionStream stream(ib);
+            auto it = map.find(std::string(stream.getMessage()));
+            if (it != map.end())
+                doNotOptimize(it->second(stream));
+        }
+    }, corpus.size());
+
+    auto registryResult = runBenchmark("decode/NMEAMessageRegistry<32 types>", 200, [&] {
+        for (const auto& s : corpus)
+            doNotOptimize(Registry::decode(ImmutableBuffer(s.data(), s.size())));
+    }, corpus.size());
+
+    runBenchmark("lookup/std::map<std::string>", 2000, [&] {
+        for (std::size_t t = 0; t < TypeCount; ++t)
+            doNotOptimize(map.find(corpus[t].substr(3, 3)) != map.end());
+    }, TypeCount);
+
+    runBenchmark("lookup/NMEAMessageRegistry<32 types>", 2000, [&] {
+        for (std::size_t t = 0; t < TypeCount; ++t)
+            doNotOptimize(Registry::contains(NMEAMessageName(std::string_view(corpus[t]).substr(3, 3))));
+    }, TypeCount);
+
+    double avg = static_cast<double>(bytes) / corpus.size();
+    std::printf("decode throughput: map %.1f MB/s, registry %.1f MB/s\n",
+                mapResult.opsPerSecond() * avg / 1e6, registryResult.opsPerSecond() * avg / 1e6);
+    return 0;
+}
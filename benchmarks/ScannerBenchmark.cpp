@@ -0,0 +1,138 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2025 Mark Wilson
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+//  https://www.boost.org/LICENSE_1_0.txt)
+//-----------------------------------------------------------------------------
+//
+// Per-sentence framing cost: the single-pass scanNMEASentence kernels against the
+// original find/rfind/split + separate checksum walk, and bulk checksum/validation rates.
+//
+#include <array>
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "NMEACommon.h"
+#include "NMEAScanner.h"
+
+#include "BenchmarkHarness.h"
+
+namespace {
+
+// The original parseMessage/splitString followed by the checksum loop.
+std::size_t legacyScan(std::string_view message, std::uint8_t& checksum)
+{
+    if (message.front() != '$' || message.find('*') == std::string_view::npos)
+        return 0;
+
+    std::size_t checksumStart = message.rfind('*');
+    std::string_view content = message.substr(1, checksumStart - 1);
+
+    std::vector<std::string_view> fields;
+    std::size_t start = 0;
+    std::size_t end = content.find(',');
+    while (end != std::string_view::npos)
+    {
+        fields.push_back(content.substr(start, end - start));
+        start = end + 1;
+        end = content.find(',', start);
+    }
+    fields.push_back(content.substr(start));
+
+    unsigned char x = 0;
+    for (std::size_t idx = 1; message[idx] != '*'; idx++)
+        x ^= message[idx];
+    checksum = x;
+
+    return fields.size();
+}
+
+} // namespace
+
+int main()
+{
+    const std::vector<std::string> corpus {
+        "$GPGGA,123519,4807.038,N,01131.000,E,1,08,0.9,545.4,M,46.9,M,,*47\r\n",
+        "$GPRMC,123519,A,4807.038,N,01131.000,E,022.4,084.4,230394,003.1,W*6A\r\n",
+        "$GPGSV,2,1,08,01,40,083,46,02,17,308,41,12,07,344,39,14,22,228,45*75\r\n",
+        "$GPVTG,054.7,T,034.4,M,005.5,N,010.2,K*48\r\n",
+    };
+
+    std::size_t bytes = 0;
+    for (const auto& s : corpus)
+        bytes += s.size();
+    std::printf("active kernel: %d, corpus average %.1f bytes/sentence\n",
+                static_cast<int>(activeNMEAScanKernel()), static_cast<double>(bytes) / corpus.size());
+
+    constexpr std::size_t Iterations = 500000;
+
+    runBenchmark("scan/legacy find+split+checksum", Iterations, [&] {
+        for (const auto& s : corpus)
+        {
+            std::uint8_t checksum = 0;
+            doNotOptimize(legacyScan(s, checksum));
+            doNotOptimize(checksum);
+        }
+    }, corpus.size());
+
+    const std::pair<const char*, NMEAScanKernel> kernels[] = {
+        { "scan/scanNMEASentence scalar", NMEAScanKernel::Scalar },
+        { "scan/scanNMEASentence SSE2", NMEAScanKernel::SSE2 },
+        { "scan/scanNMEASentence AVX2", NMEAScanKernel::AVX2 },
+    };
+
+    for (const auto& [name, kernel] : kernels)
+    {
+        if (!isNMEAScanKernelSupported(kernel))
+            continue;
+
+        std::array<std::uint16_t, 81> fields;
+        runBenchmark(name, Iterations, [&] {
+            for (const auto& s : corpus)
+            {
+                NMEAScanResult result;
+                doNotOptimize(scanNMEASentence(s, fields.data(), 80, result, kernel));
+                doNotOptimize(result);
+            }
+        }, corpus.size());
+    }
+    // Bulk validation over one large block of back to back sentences.
+    std::string block;
+    while (block.size() < (1u << 20))
+        for (const auto& s : corpus)
+            block += s;
+
+    // The original calculateNMEAChecksum loop: one byte per step until the terminator.
+    auto bytewise = runBenchmark("checksum/bytewise to terminator 1 MiB", 200, [&] {
+        const char* p = block.c_str();
+        unsigned char x = 0;
+        for (std::size_t idx = 1; p[idx] != 0; idx++)
+            x ^= static_cast<unsigned char>(p[idx]);
+        doNotOptimize(x);
+    });
+    auto wordwise = runBenchmark("checksum/xorNMEABytes 1 MiB", 200, [&] {
+        doNotOptimize(xorNMEABytes(block));
+    });
+
+    std::vector<std::string_view> sentences;
+    for (std::size_t pos = 0; pos < block.size(); )
+    {
+        std::size_t end = block.find('\n', pos) + 1;
+        sentences.push_back(std::string_view(block).substr(pos, end - pos));
+        pos = end;
+    }
+    auto validation = runBenchmark("validate/validateNMEAMessage 1 MiB", 200, [&] {
+        std::size_t valid = 0;
+        for (auto s : sentences)
+            valid += validateNMEAMessage(s);
+        doNotOptimize(valid);
+    });
+
+    const double mib = static_cast<double>(block.size()) / (1 << 20);
+    std::printf("checksum: bytewise %.0f MiB/s, xorNMEABytes %.0f MiB/s; validation %.0f MiB/s\n",
+                mib * bytewise.opsPerSecond(), mib * wordwise.opsPerSecond(), mib * validation.opsPerSecond());
+    return 0;
+}
@@ -0,0 +1,205 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2025 Mark Wilson
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+//  https://www.boost.org/LICENSE_1_0.txt)
+//-----------------------------------------------------------------------------
+//
+// Decode-and-route over a gateway's fixed set of 12 sentence types: NMEAMessageRegistry
+// decoding into AnyNMEAMessage, routed with an isType<T>() chain, against NMEAVariantMessage
+// decoding into its std::variant, routed with visit(). One of the types (GSV) is too big for
+// AnyNMEAMessage's inline buffer. The allocations column counts global operator new calls
+// per sentence. The last two runs time the routing alone, over messages decoded up front.
+//
+// Usage: VariantBenchmark [sentences]
+//
+#include <array>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "ExampleMessages.h"
+#include "NMEAMessageRegistry.h"
+#include "NMEAVariantMessage.h"
+
+#include "AllocationCounter.h"
+#include "BenchmarkHarness.h"
+#include "NMEACorpusGenerator.h"
+
+namespace {
+
+// Satellites in view: too big for the inline buffer
+struct GSVMessage
+{
+    int satellites {0};
+    std::array<double, 12> elevation {};
+};
+
+static_assert(!AnyNMEAMessage::storesInline<GSVMessage>(), "GSVMessage must take the allocating path");
+
+// The rest of the gateway's sentence types
+template <int N>
+struct SyntheticMessage
+{
+    int value {0};
+    double reading {0.0};
+};
+
+NMEAInsertionStream& operator<<(NMEAInsertionStream& stream, const GSVMessage& msg)
+{
+    return stream << msg.satellites << msg.elevation[0];
+}
+
+NMEAExtractionStream& operator>>(NMEAExtractionStream& stream, GSVMessage& msg)
+{
+    return stream >> msg.satellites >> msg.elevation[0];
+}
+
+template <int N>
+NMEAInsertionStream& operator<<(NMEAInsertionStream& stream, const SyntheticMessage<N>& msg)
+{
+    return stream << msg.value << msg.reading;
+}
+
+template <int N>
+NMEAExtractionStream& operator>>(NMEAExtractionStream& stream, SyntheticMessage<N>& msg)
+{
+    return stream >> msg.value >> msg.reading;
+}
+
+double routeValue(const GGAMessage& m) { return m.d; }
+double routeValue(const RMCMessage& m) { return m.d; }
+double routeValue(const GSVMessage& m) { return m.elevation[0]; }
+template <int N>
+double routeValue(const SyntheticMessage<N>& m) { return m.reading + N; }
+
+} // namespace
+
+template <>
+struct NMEATraits<GSVMessage>
+{
+    static constexpr NMEAMessageName messageName() { return "GSV"; }
+};
+
+template <int N>
+struct NMEATraits<SyntheticMessage<N>>
+{
+    static constexpr char Name[] = {'X', static_cast<char>('0' + N / 10), static_cast<char>('0' + N % 10), 0};
+    static constexpr NMEAMessageName messageName() { return Name; }
+};
+
+namespace {
+
+#define GATEWAY_TYPES GGAMessage, RMCMessage, GSVMessage, \
+    SyntheticMessage<1>, SyntheticMessage<2>, SyntheticMessage<3>, SyntheticMessage<4>, SyntheticMessage<5>, \
+    SyntheticMessage<6>, SyntheticMessage<7>, SyntheticMessage<8>, SyntheticMessage<9>
+
+using Registry = NMEAMessageRegistry<GATEWAY_TYPES>;
+using GatewayMessage = NMEAVariantMessage<GATEWAY_TYPES>;
+
+template <class... Types>
+double routeByChain(const AnyNMEAMessage& m, const NMEAVariantMessage<Types...>*)
+{
+    double value = 0.0;
+    (void)((m.isType<Types>() ? (value = routeValue(m.get<Types>()), true) : false) || ...);
+    return value;
+}
+
+template <class F>
+void measure(const char* label, std::size_t count, F body)
+{
+    const std::size_t before = allocationCount();
+    body();
+    const double allocations = static_cast<double>(allocationCount() - before) / count;
+
+    char name[96];
+    std::snprintf(name, sizeof(name), "%s (%.2f allocs/sentence)", label, allocations);
+    runBenchmark(name, 10, body, count);
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const std::size_t count = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 60000;
+
+    std::vector<std::string> storage;
+    storage.reserve(count);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const std::string n = std::to_string(i % 997);
+        switch (i % 12)
+        {
+        case 0: storage.push_back(makeNMEASentence("GPGGA," + n + "," + n + ".5,FIX")); break;
+        case 1: storage.push_back(makeNMEASentence("GPRMC," + n + "," + n + ".25")); break;
+        case 2: storage.push_back(makeNMEASentence("GPGSV," + n + "," + n + ".75")); break;
+        default: storage.push_back(makeNMEASentence("GPX0" + std::to_string(i % 12 - 2) + "," + n + "," + n + ".125"));
+        }
+    }
+
+    std::vector<ImmutableBuffer> input;
+    input.reserve(count);
+    for (const auto& s : storage)
+        input.emplace_back(s.data(), s.size());
+
+    std::printf("%zu sentences over %zu types; sizeof AnyNMEAMessage %zu, sizeof NMEAVariantMessage %zu\n",
+                count, GatewayMessage::size(), sizeof(AnyNMEAMessage), sizeof(GatewayMessage));
+
+    measure("AnyNMEAMessage, isType chain", count, [&] {
+        NMEAExtractionStream stream;
+        AnyNMEAMessage m;
+        double sum = 0.0;
+        for (const auto& sentence : input)
+        {
+            stream.rebind(sentence);
+            if (Registry::tryDecode(stream, m) == NMEADecodeStatus::Ok)
+                sum += routeByChain(m, static_cast<const GatewayMessage*>(nullptr));
+        }
+        doNotOptimize(sum);
+    });
+
+    measure("NMEAVariantMessage, visit", count, [&] {
+        NMEAExtractionStream stream;
+        GatewayMessage m;
+        double sum = 0.0;
+        for (const auto& sentence : input)
+        {
+            stream.rebind(sentence);
+            if (GatewayMessage::tryDecode(stream, m) == NMEADecodeStatus::Ok)
+                sum += m.visit([](const auto& payload) { return routeValue(payload); });
+        }
+        doNotOptimize(sum);
+    });
+
+    // Routing alone, over messages decoded up front
+    std::vector<AnyNMEAMessage> anyMessages(count);
+    std::vector<GatewayMessage> variantMessages(count);
+    {
+        NMEAExtractionStream stream;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            stream.rebind(input[i]);
+            Registry::tryDecode(stream, anyMessages[i]);
+            stream.rebind(input[i]);
+            GatewayMessage::tryDecode(stream, variantMessages[i]);
+        }
+    }
+
+    runBenchmark("route only: AnyNMEAMessage, isType chain", 20, [&] {
+        double sum = 0.0;
+        for (const auto& m : anyMessages)
+            sum += routeByChain(m, static_cast<const GatewayMessage*>(nullptr));
+        doNotOptimize(sum);
+    }, count);
+
+    runBenchmark("route only: NMEAVariantMessage, visit", 20, [&] {
+        double sum = 0.0;
+        for (const auto& m : variantMessages)
+            sum += m.visit([](const auto& payload) { return routeValue(payload); });
+        doNotOptimize(sum);
+    }, count);
+
+    return 0;
+}
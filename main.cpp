@@ -7,8 +7,12 @@
 //-----------------------------------------------------------------------------
 #include <iostream>
 #include <string>
+#include <cstring>
 
 #include "AnyNMEAMessage.h"
+#include "ExampleMessages.h"
+#include "NMEAMessageRegistry.h"
+#include "NMEASentenceFramer.h"
 
 #include "NMEAInsertionStream.h"
 #include "NMEAExtractionStream.h"
@@ -18,86 +22,6 @@
 
 using namespace std;
 
-//
-// Strawmen NMEA messages to keep things simple.
-//
-struct GGAMessage
-{
-    int i{42};
-    double d{123.456};
-    std::string s{"STRING"};
-};
-
-ostream &operator<<(ostream &str, const GGAMessage &msg)
-{
-    str << "GGA: i = " << msg.i << ", d = " << msg.d << ", s = " << msg.s;
-    return str;
-}
-
-NMEAInsertionStream &operator<<(NMEAInsertionStream &stream, const GGAMessage &msg)
-{
-    stream << msg.i;
-    stream << msg.d;
-    stream << msg.s;
-    stream << NMEAInsertionStream::EndMsg();
-
-    return stream;
-}
-
-NMEAExtractionStream &operator>>(NMEAExtractionStream &stream, GGAMessage &msg)
-{
-    stream >> msg.i;
-    stream >> msg.d;
-    stream >> msg.s;
-
-    return stream;
-}
-
-
-
-
-struct RMCMessage
-{
-    double d{456.789};
-    int i{105};
-};
-
-ostream &operator<<(ostream &str, const RMCMessage &msg)
-{
-    str << "RMC: d = " << msg.d << ", i = " << msg.i;
-    return str;
-}
-
-NMEAInsertionStream &operator<<(NMEAInsertionStream &stream, const RMCMessage &msg)
-{
-    stream << msg.i;
-    stream << msg.d;
-    stream << NMEAInsertionStream::EndMsg();
-
-    return stream;
-}
-
-NMEAExtractionStream &operator>>(NMEAExtractionStream &stream, RMCMessage &msg)
-{
-    stream >> msg.i;
-    stream >> msg.d;
-
-    return stream;
-}
-
-template<>
-struct NMEATraits<GGAMessage>
-{
-    static std::string messageName() { return "GGA"; }
-};
-
-template<>
-struct NMEATraits<RMCMessage>
-{
-    static std::string messageName() { return "RMC"; }
-};
-
-
 void testQueryAndAccessors()
 {
     cout << "TEST QUERY AND ACCESSORS" << endl;
@@ -174,13 +98,59 @@ void testSerialization()
     GGAMessage gga1{1, 43.34, "HELLO"};
     AnyNMEAMessage m1("MW", gga1);
 
-    char buffer[1024];
-    MutableBuffer mb(buffer, 1024);
+    // Sized from the schema: any GGAMessage fits, trailer and NUL included
+    NMEASchema<GGAMessage>::Buffer buffer;
+    MutableBuffer mb(buffer.data(), buffer.size());
 
     NMEAInsertionStream nis(mb, "GT", "GGA");
     m1.serialize(nis);
 
-    cout << "Serialized GGA message is " << buffer << endl;
+    cout << "Serialized GGA message is " << buffer.data() << endl;
+}
+
+void testFactory()
+{
+    cout << "TEST FACTORY" << endl;
+    cout << "===================================" << endl;
+
+    using Registry = NMEAMessageRegistry<GGAMessage, RMCMessage>;
+
+    const char* sentences[] = { "$GPGGA,7,1.5,ABC*27", "$GPRMC,105,456.789*50", "$GPXYZ,1*4B" };
+
+    for (const char* sentence : sentences)
+    {
+        ImmutableBuffer ib(sentence, strlen(sentence));
+        AnyNMEAMessage m = Registry::decode(ib);
+
+        if (m.isType<GGAMessage>())
+            cout << m.getTalker() << " " << m.get<GGAMessage>() << endl;
+        else if (m.isType<RMCMessage>())
+            cout << m.getTalker() << " " << m.get<RMCMessage>() << endl;
+        else
+            cout << "No registered type for " << sentence << endl;
+    }
+}
+
+void testFramer()
+{
+    cout << "TEST FRAMER" << endl;
+    cout << "===================================" << endl;
+
+    using Registry = NMEAMessageRegistry<GGAMessage, RMCMessage>;
+
+    // Two sentences with line noise in between, arriving in awkward 7 byte reads
+    const string wire = "$GPGGA,7,1.5,ABC*27\r\n#@!noise$GPRMC,105,456.789*50\r\n";
+
+    NMEASentenceFramer framer;
+    for (size_t pos = 0; pos < wire.size(); pos += 7)
+    {
+        framer.feed(wire.data() + pos, min<size_t>(7, wire.size() - pos), [](const ImmutableBuffer& sentence) {
+            AnyNMEAMessage m = Registry::decode(sentence);
+            cout << "Framed " << m.getTalker() << m.getMessageName() << endl;
+        });
+    }
+
+    cout << "Dropped " << framer.counters().droppedBytes << " bytes" << endl;
 }
 
 int main()
@@ -188,6 +158,8 @@ int main()
     testQueryAndAccessors();
     testCopy();
     testSerialization();
+    testFactory();
+    testFramer();
 
     return 0;
 }